@@ -0,0 +1,55 @@
+#pragma once
+
+#include "candidate.hpp"
+#include "config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+struct beam_search_options {
+  // The number of partial trees kept at each depth.
+  std::size_t width{1000};
+
+  // The number of random playouts used to score each candidate. If 0,
+  // candidates are scored only by the size of the border they would have.
+  std::size_t n_playouts{0};
+
+  // Seed for the random playouts. Results, including which of several equally
+  // large trees is returned, are reproducible for a given seed, regardless of
+  // the number of threads.
+  std::uint64_t seed{0};
+
+  unsigned n_threads{std::thread::hardware_concurrency()};
+};
+
+/**
+ * @brief Searches for large induced subtrees with a beam search. Starting from
+ * every single vertex, each depth extends every partial tree in the beam by one
+ * vertex in every possible way, then keeps the best `width` distinct
+ * extensions that do not enclose space. Extensions are scored by the number of
+ * vertices that could be added next, or by the best of a few random playouts.
+ *
+ * Every depth produces a tree one vertex larger. The deepest so far is passed
+ * to the sink about once a second, and at the end, so this gives an increasing
+ * lower bound as it runs.
+ *
+ * Each depth scores every extension of every tree in the beam, which takes
+ * time proportional to the width and the size of the trees' borders, and
+ * copies any tree that is extended in more than one way. A whole search is so
+ * roughly quadratic in the size of the graph, and lattices of around 100^3 are
+ * out of reach even with the implicit graph, which only saves the memory of
+ * the graph itself.
+ *
+ * Defined for hrp_graph and implicit_hrp_graph, the latter for lattices too
+ * large to materialize.
+ *
+ * @param graph The graph to search
+ * @param options Search parameters
+ * @param sink Receives every candidate that may be the new best
+ * @return The largest subtree found without enclosed space
+ */
+template <class graph_t>
+subtree<graph_t> beam_search(const graph_t &graph,
+                             const beam_search_options &options,
+                             basic_candidate_sink<graph_t> &sink);
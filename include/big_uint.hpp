@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @brief An unsigned integer with no upper limit, for counts of subtrees,
+ * which pass 64 bits on graphs with more than 64 vertices. Only what counting
+ * needs is here: addition, comparison and printing.
+ */
+class big_uint {
+public:
+  big_uint() = default;
+
+  explicit big_uint(std::uint64_t value);
+
+  /**
+   * @brief Constructs from 32 bit limbs, least significant first.
+   */
+  explicit big_uint(std::span<const std::uint32_t> limbs);
+
+  big_uint &operator+=(const big_uint &other);
+
+  [[nodiscard]] bool operator==(const big_uint &other) const = default;
+
+  /**
+   * @brief Gets the value in decimal.
+   */
+  [[nodiscard]] std::string to_string() const;
+
+  friend std::ostream &operator<<(std::ostream &stream, const big_uint &value) {
+    return stream << value.to_string();
+  }
+
+private:
+  // Least significant first, with no leading zero limbs, so 0 has none.
+  std::vector<std::uint32_t> m_limbs;
+};
@@ -5,13 +5,16 @@
  * subtree, which is assumed to already have happened. Keeps track of the
  * modifications that were performed.
  *
+ * Defined for subtrees of hrp_graph and implicit_hrp_graph.
+ *
  * @param sub The subtree that was added to
  * @param border The border to update
  * @param id The vertex that was added
  * @param history Used to store the actions that were performed
  */
-void update(const subtree_type &sub, border_type &border, const vertex_id id,
-            history_type &history);
+template <class graph_t>
+void update(const subtree<graph_t> &sub, border_type &border,
+            const vertex_id id, history_type &history);
 
 /**
  * @brief Restores the last state of the border
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "config.hpp"
+
+#include <atomic>
+#include <ctime>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+// Everything here is defined for hrp_graph and implicit_hrp_graph.
+
+/**
+ * @brief Checks if a subtree encloses space, that is, if there are non-induced
+ * vertices that cannot be reached from the outer shell of the graph without
+ * passing through an induced vertex.
+ * @param graph The graph the subtree is a subgraph of
+ * @param sub The subtree to check
+ * @return true iff the subtree encloses space
+ */
+template <class graph_t>
+[[nodiscard]] bool has_enclosed_space(const graph_t &graph,
+                                      const subtree<graph_t> &sub);
+
+/**
+ * @brief Checks if adding a vertex to a subtree that does not enclose space
+ * would make it enclose space. Only the non-induced vertices around the new one
+ * can be cut off by it, and if they are still connected to each other close to
+ * it, nothing is, so the whole graph is only searched when they are not.
+ * Enclosed space can never be opened by adding vertices, as the last vertex of
+ * a pocket to be added would have at least two induced neighbors.
+ * @param graph The graph the subtree is a subgraph of
+ * @param sub The subtree to add to, which must not enclose space
+ * @param id The vertex to add, which is not induced
+ * @return true iff the subtree would enclose space with id added
+ */
+template <class graph_t>
+[[nodiscard]] bool encloses_space_by_adding(const graph_t &graph,
+                                            const subtree<graph_t> &sub,
+                                            vertex_id id);
+
+/**
+ * @brief Writes a subtree in the result file format: the dimensions of the
+ * graph, then one character per vertex ('X' if induced, '_' if not), then the
+ * number of induced vertices. This is the same format written by the
+ * Monte-Carlo and enumeration programs, and read by the analyzer.
+ * @param stream The stream to write to
+ * @param graph The graph the subtree is a subgraph of
+ * @param sub The subtree to write
+ */
+template <class graph_t>
+void write_subtree(std::ostream &stream, const graph_t &graph,
+                   const subtree<graph_t> &sub);
+
+/**
+ * @brief Collects candidate subtrees from a search, and keeps the largest seen
+ * so far written to a file. Subtrees that enclose space are tracked separately,
+ * and written to a file with "_enclosed" appended to the name.
+ */
+template <class graph_t> class basic_candidate_sink {
+public:
+  /**
+   * @brief Constructs a candidate sink.
+   * @param graph The graph that all candidates are subgraphs of
+   * @param outfile The file to write the best candidate to
+   */
+  basic_candidate_sink(const graph_t &graph, std::string outfile);
+
+  /**
+   * @brief Checks if a subtree is larger than any seen so far, and if so,
+   * records it, writes it to the output file, and logs it. Thread-safe.
+   * @param sub The candidate
+   * @return true iff the candidate is the new largest subtree without enclosed
+   * space
+   */
+  bool check(const subtree<graph_t> &sub);
+
+  /**
+   * @brief Gets the size of the largest subtree without enclosed space seen so
+   * far. Can be called without synchronization, to avoid calling check() on
+   * candidates that are clearly not better.
+   */
+  [[nodiscard]] vertex_id largest() const { return m_largest_tree; }
+
+private:
+  const graph_t &m_graph;
+  std::string m_outfile;
+
+  std::mutex m_mutex;
+  std::atomic<vertex_id> m_largest_tree{0};
+  vertex_id m_largest_with_enclosed{0};
+
+  std::clock_t m_start_time;
+};
+
+using candidate_sink = basic_candidate_sink<graph_type>;
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "reduced_graph.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+/**
+ * @brief A cycle of a directed graph, with its total vertex weight. The cycle
+ * is empty if the graph has none.
+ */
+struct cycle_ratio {
+  std::uint64_t weight = 0, length = 0;
+  std::vector<std::uint32_t> cycle;
+
+  // True iff this cycle has a larger mean than other, or the same mean but is
+  // shorter.
+  [[nodiscard]] bool better_than(const cycle_ratio &other) const {
+    if (length == 0) {
+      return false;
+    }
+    if (other.length == 0) {
+      return true;
+    }
+
+    const auto lhs = weight * other.length, rhs = other.weight * length;
+    return lhs > rhs || (lhs == rhs && length < other.length);
+  }
+};
+
+namespace cycle_ratio_detail {
+
+// Howard's algorithm on one strongly connected component, given its vertices.
+// local gives the index of each vertex in its component, adj and weight are
+// for the whole graph.
+template <class adj_t, class weight_t>
+[[nodiscard]] cycle_ratio
+solve_component(const std::vector<std::uint32_t> &verts,
+                const std::vector<std::uint32_t> &comp,
+                const std::vector<std::uint32_t> &local, const adj_t &adj,
+                const weight_t &weight) {
+  const auto n = static_cast<std::uint32_t>(verts.size());
+  const auto c = comp[verts[0]];
+
+  std::vector<std::vector<std::uint32_t>> out(n);
+  for (std::uint32_t i = 0; i < n; ++i) {
+    for (const std::uint32_t v : adj(verts[i])) {
+      if (comp[v] == c) {
+        out[i].push_back(local[v]);
+      }
+    }
+  }
+
+  std::vector<std::uint64_t> w(n);
+  for (std::uint32_t i = 0; i < n; ++i) {
+    w[i] = weight(verts[i]);
+  }
+
+  // Start with the heaviest successor of each vertex.
+  std::vector<std::uint32_t> policy(n);
+  for (std::uint32_t i = 0; i < n; ++i) {
+    policy[i] = *std::ranges::max_element(
+        out[i], [&w](auto a, auto b) { return w[a] < w[b]; });
+  }
+
+  // eta of each vertex is p[i]/q[i], potentials are scaled by q[i].
+  std::vector<std::uint64_t> p(n), q(n);
+  std::vector<std::int64_t> x(n);
+
+  // 0 is unvisited, 1 is on the current walk, 2 is done.
+  std::vector<std::uint8_t> state(n);
+  std::vector<std::uint32_t> walk, cycle;
+
+  const auto less = [&p, &q](std::uint32_t a, std::uint32_t b) {
+    return p[a] * q[b] < p[b] * q[a];
+  };
+
+  const auto candidate = [&](std::uint32_t u, std::uint32_t v) {
+    return static_cast<std::int64_t>(q[u] * w[v]) -
+           static_cast<std::int64_t>(p[u]) + x[v];
+  };
+
+  // Sets eta and the potential of u from its policy successor.
+  const auto set_from_policy = [&](std::uint32_t u) {
+    const auto next = policy[u];
+    p[u] = p[next];
+    q[u] = q[next];
+    x[u] = candidate(u, next);
+    state[u] = 2;
+  };
+
+  while (true) {
+    // Value determination
+    std::ranges::fill(state, std::uint8_t{0});
+    for (std::uint32_t s = 0; s < n; ++s) {
+      if (state[s] != 0) {
+        continue;
+      }
+
+      auto u = s;
+      for (; state[u] == 0; u = policy[u]) {
+        state[u] = 1;
+        walk.push_back(u);
+      }
+
+      // A new cycle. Its potentials are measured from its smallest vertex,
+      // so they do not change while the cycle does not.
+      if (state[u] == 1) {
+        auto root = u;
+        for (auto v = policy[u]; v != u; v = policy[v]) {
+          root = std::min(root, v);
+        }
+
+        cycle.clear();
+        std::uint64_t cycle_weight = 0;
+        auto v = root;
+        do {
+          cycle.push_back(v);
+          cycle_weight += w[v];
+          v = policy[v];
+        } while (v != root);
+
+        const auto g = std::gcd(cycle_weight, std::uint64_t{cycle.size()});
+        p[root] = cycle_weight / g;
+        q[root] = cycle.size() / g;
+        x[root] = 0;
+        state[root] = 2;
+
+        for (auto i = cycle.size() - 1; i > 0; --i) {
+          set_from_policy(cycle[i]);
+        }
+      }
+
+      // Everything else on the walk leads to u.
+      while (!walk.empty()) {
+        if (state[walk.back()] != 2) {
+          set_from_policy(walk.back());
+        }
+        walk.pop_back();
+      }
+    }
+
+    // Policy improvement
+    bool changed = false;
+    for (std::uint32_t u = 0; u < n; ++u) {
+      auto best = policy[u];
+      for (const auto v : out[u]) {
+        if (less(best, v)) {
+          best = v;
+        }
+      }
+
+      if (best == policy[u]) {
+        // No better eta, look for a better potential among successors with
+        // the same eta.
+        auto best_x = x[u];
+        for (const auto v : out[u]) {
+          if (less(v, u) || less(u, v)) {
+            continue;
+          }
+
+          const auto value = candidate(u, v);
+          if (value > best_x) {
+            best_x = value;
+            best = v;
+          }
+        }
+      }
+
+      if (best != policy[u]) {
+        policy[u] = best;
+        changed = true;
+      }
+    }
+
+    if (!changed) {
+      break;
+    }
+  }
+
+  // Find the shortest cycle using only tight edges among the vertices with
+  // the best eta, breadth first from each of them.
+  std::uint32_t top = 0;
+  for (std::uint32_t u = 1; u < n; ++u) {
+    if (less(top, u)) {
+      top = u;
+    }
+  }
+
+  const auto tight = [&](std::uint32_t u, std::uint32_t v) {
+    return !less(u, top) && !less(v, top) && candidate(u, v) == x[u];
+  };
+
+  cycle_ratio result;
+  constexpr auto unseen = static_cast<std::uint32_t>(-1);
+  std::vector<std::uint32_t> parent(n), dist(n, unseen), visited;
+  for (std::uint32_t s = 0; s < n; ++s) {
+    if (less(s, top)) {
+      continue;
+    }
+
+    // Only reset what the last search reached.
+    for (const auto v : visited) {
+      dist[v] = unseen;
+    }
+    visited.clear();
+
+    std::queue<std::uint32_t> to_visit;
+    dist[s] = 0;
+    visited.push_back(s);
+    to_visit.push(s);
+
+    bool found = false;
+    while (!to_visit.empty() && !found) {
+      const auto u = to_visit.front();
+      to_visit.pop();
+
+      // Only a shorter cycle than the best is of interest.
+      if (result.length != 0 && dist[u] + 1 >= result.length) {
+        break;
+      }
+
+      for (const auto v : out[u]) {
+        if (!tight(u, v)) {
+          continue;
+        }
+
+        if (v == s) {
+          result.cycle.clear();
+          result.weight = 0;
+          for (auto y = u;; y = parent[y]) {
+            result.cycle.push_back(verts[y]);
+            result.weight += w[y];
+            if (y == s) {
+              break;
+            }
+          }
+          std::ranges::reverse(result.cycle);
+          result.length = result.cycle.size();
+          found = true;
+          break;
+        }
+
+        if (dist[v] == unseen) {
+          visited.push_back(v);
+          dist[v] = dist[u] + 1;
+          parent[v] = u;
+          to_visit.push(v);
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+} // namespace cycle_ratio_detail
+
+/**
+ * @brief Finds the cycle of a directed graph with the largest mean vertex
+ * weight, using Howard's policy iteration on each strongly connected
+ * component.
+ *
+ * A policy picks one successor of every vertex, so following it from any
+ * vertex ends in a cycle. Each vertex is given the mean weight (eta) of the
+ * cycle its policy reaches, and a potential (x) which is the weight of the
+ * path there, less eta per step. Then every vertex switches to a successor
+ * with a higher eta if there is one, or else one that gives it a higher
+ * potential. When no vertex switches, the best policy cycle has the maximum
+ * mean. All arithmetic is exact, eta is kept as a reduced fraction p/q and
+ * potentials are scaled by q.
+ *
+ * Among the cycles with the maximum mean, the shortest is returned. Every such
+ * cycle uses only edges where the potential is tight, so these are searched
+ * breadth first.
+ * @param n The number of vertices
+ * @param adj adj(u) gives the successors of u
+ * @param weight weight(u) gives the weight of u
+ * @return The cycle, which is empty if the graph has no cycles
+ */
+template <class adj_t, class weight_t>
+[[nodiscard]] cycle_ratio max_cycle_ratio(std::uint32_t n, const adj_t &adj,
+                                          const weight_t &weight) {
+  std::vector<std::uint32_t> comp;
+  const auto n_comps = strongly_connected_components(n, adj, comp);
+
+  std::vector<std::vector<std::uint32_t>> members(n_comps);
+  std::vector<std::uint32_t> local(n);
+  for (std::uint32_t u = 0; u < n; ++u) {
+    local[u] = static_cast<std::uint32_t>(members[comp[u]].size());
+    members[comp[u]].push_back(u);
+  }
+
+  cycle_ratio best;
+  for (const auto &verts : members) {
+    // A single vertex only has a cycle if it has a loop.
+    if (verts.size() == 1) {
+      const auto &out = adj(verts[0]);
+      if (std::ranges::find(out, verts[0]) == std::ranges::end(out)) {
+        continue;
+      }
+    }
+
+    auto candidate =
+        cycle_ratio_detail::solve_component(verts, comp, local, adj, weight);
+    if (candidate.better_than(best)) {
+      best = std::move(candidate);
+    }
+  }
+
+  return best;
+}
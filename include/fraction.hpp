@@ -0,0 +1,27 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @brief A nonnegative fraction, used for the densities of tiles. Fractions
+ * of equal value compare greater the smaller their denominator, so of two
+ * tiles as dense as each other, the shorter is the greater.
+ */
+struct fraction {
+  std::uint64_t num = 0, den = 1;
+
+  friend std::strong_ordering operator<=>(const fraction &a,
+                                          const fraction &b) {
+    const auto result = a.num * b.den <=> b.num * a.den;
+    return result == 0 ? b.den <=> a.den : result;
+  }
+
+  friend bool operator==(const fraction &a, const fraction &b) = default;
+
+  friend std::ostream &operator<<(std::ostream &stream, const fraction &f) {
+    return stream << f.num << '/' << f.den << " = "
+                  << static_cast<double>(f.num) / static_cast<double>(f.den);
+  }
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "concepts.hpp"
+#include "semiarray.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+/*
+HRP = Hyper-Rectangular Prism
+
+An implicit hrp graph has the same interface as hrp_graph, but stores nothing
+per vertex. A vertex's neighbors and directions are computed from its
+coordinates whenever it is looked up, so lattices far too large to hold as an
+hrp_graph cost only their shape.
+*/
+class implicit_hrp_graph {
+public:
+  using vertex_id = std::uint32_t;
+
+  constexpr static vertex_id no_vertex = std::numeric_limits<vertex_id>::max();
+
+  // The most dimensions a graph can have.
+  constexpr static std::size_t max_dims = 8;
+
+  struct vertex {
+    // As for hrp_graph: neighbors in ascending order of ID, and directions
+    // with no_vertex where there is no neighbor.
+    semiarray<vertex_id, 2 * max_dims> neighbors;
+    semiarray<vertex_id, 2 * max_dims> directions;
+  };
+
+  // Looks up vertices by ID like the vector of an hrp_graph, computing each
+  // one on demand. Holds a copy of the shape of the graph rather than
+  // referring to it, so subtrees can keep one.
+  class vertex_range {
+  public:
+    [[nodiscard]] std::size_t size() const { return m_dim_sizes[m_n_dims]; }
+
+    [[nodiscard]] vertex_id size_of_dim(std::size_t d) const {
+      return m_dim_sizes[d];
+    }
+
+    [[nodiscard]] vertex_id get_coord(std::size_t d, vertex_id vid) const {
+      return (vid / size_of_dim(d)) % m_dims[d];
+    }
+
+    [[nodiscard]] vertex_id forward(std::size_t d, vertex_id vid) const {
+      return (get_coord(d, vid) == m_dims[d] - 1) ? no_vertex
+                                                  : vid + size_of_dim(d);
+    }
+
+    [[nodiscard]] vertex_id backward(std::size_t d, vertex_id vid) const {
+      return (get_coord(d, vid) == 0) ? no_vertex : vid - size_of_dim(d);
+    }
+
+    [[nodiscard]] vertex operator[](std::size_t index) const {
+      const auto vid = static_cast<vertex_id>(index);
+
+      // The same order as hrp_graph: backwards from the highest dimension
+      // down, then forwards from the lowest up, which is ascending order of
+      // ID.
+      vertex result;
+      for (std::size_t d = m_n_dims; d-- > 0;) {
+        result.directions.push_back(backward(d, vid));
+      }
+      for (std::size_t d = 0; d < m_n_dims; ++d) {
+        result.directions.push_back(forward(d, vid));
+      }
+
+      for (const auto n : result.directions) {
+        if (n != no_vertex) {
+          result.neighbors.push_back(n);
+        }
+      }
+      return result;
+    }
+
+    [[nodiscard]] vertex at(std::size_t index) const {
+      if (index >= size()) {
+        throw std::out_of_range{"implicit_hrp_graph: no such vertex"};
+      }
+      return (*this)[index];
+    }
+
+    [[nodiscard]] auto operator<=>(const vertex_range &) const = default;
+
+  private:
+    std::size_t m_n_dims{0};
+    std::array<vertex_id, max_dims> m_dims{};
+    // Accumulated size of each dimension
+    std::array<vertex_id, max_dims + 1> m_dim_sizes{};
+
+    friend class implicit_hrp_graph;
+  };
+
+  [[nodiscard]] implicit_hrp_graph(
+      const detail::range_of_convertible_to<vertex_id> auto &dims)
+      : dims_array(dims.begin(), dims.end()) {
+    assert(dims_array.size() <= max_dims);
+
+    vertices.m_n_dims = dims_array.size();
+    vertices.m_dim_sizes.front() = 1;
+    for (std::size_t d = 0; d < dims_array.size(); ++d) {
+      assert(std::uint64_t{vertices.m_dim_sizes[d]} * dims_array[d] <
+             no_vertex);
+      vertices.m_dims[d] = dims_array[d];
+      vertices.m_dim_sizes[d + 1] = vertices.m_dim_sizes[d] * dims_array[d];
+    }
+  }
+
+  [[nodiscard]] implicit_hrp_graph(std::initializer_list<vertex_id> dims)
+      : implicit_hrp_graph{std::span{dims.begin(), dims.end()}} {}
+
+  [[nodiscard]] vertex_id size_of_dim(std::size_t d) const {
+    return vertices.size_of_dim(d);
+  }
+
+  [[nodiscard]] vertex_id get_coord(std::size_t d, vertex_id vid) const {
+    return vertices.get_coord(d, vid);
+  }
+
+  [[nodiscard]] vertex_id forward(std::size_t d, vertex_id vid) const {
+    return vertices.forward(d, vid);
+  }
+
+  [[nodiscard]] vertex_id backward(std::size_t d, vertex_id vid) const {
+    return vertices.backward(d, vid);
+  }
+
+  // Returns true iff vid is an element on the outer shell of the
+  // hypercube.
+  [[nodiscard]] bool is_on_outer_shell(vertex_id vid) const {
+    for (std::size_t d = 0; d < dims_array.size(); ++d) {
+      const auto coord = get_coord(d, vid);
+      if (coord == 0 || coord == dims_array[d] - 1) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Vertices
+  vertex_range vertices;
+
+  // Dimension array passed into constructor
+  const std::vector<vertex_id> dims_array;
+
+  [[nodiscard]] auto operator<=>(const implicit_hrp_graph &) const = default;
+};
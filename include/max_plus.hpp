@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief A dense square matrix over the max-plus (tropical) semiring, where
+ * addition is max and multiplication is +. Entry (i,j) of the nth power of a
+ * weighted adjacency matrix is then the heaviest walk of n edges from i to j.
+ *
+ * Missing edges are none, which is small enough that adding two of them cannot
+ * overflow, and anything at or below none / 2 is treated as none. Entries are
+ * 32 bits so the inner loop vectorizes, walk weights must stay below max.
+ */
+class max_plus_matrix {
+public:
+  using value_type = std::int32_t;
+
+  constexpr static value_type none =
+      std::numeric_limits<value_type>::min() / 4;
+  constexpr static value_type max = -(none / 4);
+
+  [[nodiscard]] constexpr static bool missing(value_type v) {
+    return v <= none / 2;
+  }
+
+  explicit max_plus_matrix(std::uint32_t n)
+      : m_n{n}, m_entries(std::size_t{n} * n, none) {}
+
+  // The identity, 0 on the diagonal and none elsewhere.
+  [[nodiscard]] static max_plus_matrix identity(std::uint32_t n);
+
+  [[nodiscard]] std::uint32_t size() const { return m_n; }
+
+  value_type &operator()(std::uint32_t i, std::uint32_t j) {
+    return m_entries[std::size_t{i} * m_n + j];
+  }
+  value_type operator()(std::uint32_t i, std::uint32_t j) const {
+    return m_entries[std::size_t{i} * m_n + j];
+  }
+
+  /**
+   * @brief Multiplies two matrices of the same size. Rows are split between
+   * threads, and each thread works through blocks of the inner and column
+   * indices so that the rows of other it reads stay in cache.
+   */
+  [[nodiscard]] max_plus_matrix operator*(const max_plus_matrix &other) const;
+
+  // This to the given power, with O(log power) products.
+  [[nodiscard]] max_plus_matrix pow(std::uint64_t power) const;
+
+private:
+  std::uint32_t m_n;
+  std::vector<value_type> m_entries;
+
+  value_type *row(std::uint32_t i) {
+    return m_entries.data() + std::size_t{i} * m_n;
+  }
+  const value_type *row(std::uint32_t i) const {
+    return m_entries.data() + std::size_t{i} * m_n;
+  }
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Invokes an action on every index in [0, n), spread over a number of
+ * threads. Indexes are handed out dynamically in small chunks, so uneven
+ * amounts of work per index are balanced between threads. Blocks until all
+ * indexes have been processed.
+ * @param n The number of indexes
+ * @param action The action to invoke on each index. Will be invoked
+ * concurrently, so must be thread-safe.
+ * @param n_threads The number of threads to use, defaults to the number of
+ * hardware threads.
+ */
+template <std::invocable<std::size_t> TAction>
+void parallel_for(std::size_t n, TAction &&action,
+                  unsigned n_threads = std::thread::hardware_concurrency()) {
+  // Aim for a few chunks per thread, so that no thread is left idle for long.
+  n_threads = std::max(1u, n_threads);
+  const std::size_t chunk_size = std::max<std::size_t>(1, n / (8 * n_threads));
+
+  std::atomic<std::size_t> next{0};
+  const auto worker = [&] {
+    for (std::size_t begin; (begin = next.fetch_add(chunk_size)) < n;) {
+      const auto end = std::min(n, begin + chunk_size);
+      for (std::size_t i = begin; i < end; ++i) {
+        action(i);
+      }
+    }
+  };
+
+  if (n_threads == 1 || n <= chunk_size) {
+    worker();
+    return;
+  }
+
+  std::vector<std::jthread> threads;
+  threads.reserve(n_threads - 1);
+  for (unsigned i = 1; i < n_threads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+}
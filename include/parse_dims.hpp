@@ -0,0 +1,44 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+/**
+ * @brief Parses a whole number from a command line argument.
+ * @param str The string to parse
+ * @return The number, or nothing if that is not all the string is
+ */
+[[nodiscard]] inline std::optional<std::size_t>
+parse_size(const std::string &str) {
+  std::size_t value = 0;
+  const auto end = str.data() + str.size();
+  const auto [ptr, ec] = std::from_chars(str.data(), end, value);
+  if (ec != std::errc{} || ptr != end) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+/**
+ * @brief Parses dimensions from a command line argument, like 3,4,5.
+ * @param arg A comma separated list of dimensions
+ * @return The dimensions, or nothing if any of them is not a whole number
+ */
+[[nodiscard]] inline std::optional<std::vector<std::size_t>>
+parse_dims(const std::string &arg) {
+  std::vector<std::size_t> dims;
+  std::istringstream stream{arg};
+  for (std::string dim; std::getline(stream, dim, ',');) {
+    const auto value = parse_size(dim);
+    if (!value) {
+      return std::nullopt;
+    }
+    dims.push_back(*value);
+  }
+  return dims;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The vertex that precedes each vertex on the best path of each length
+ * found by a path DP, which is all that is needed to rebuild the path. Scores
+ * are only needed for the last layer, so DPs keep those separately.
+ *
+ * Each entry takes only as many bits as a vertex ID needs, and layers are
+ * added as the DP reaches them instead of all at once. A layer starts on a
+ * word boundary, and any 64 consecutive entries starting at a multiple of 64
+ * fill whole words, so threads can set entries in such blocks at the same
+ * time.
+ */
+class predecessor_matrix {
+public:
+  explicit predecessor_matrix(std::uint32_t n_vertices)
+      : m_bits{std::max(1u, static_cast<unsigned>(std::bit_width(n_vertices)))},
+        m_words_per_layer{(std::size_t{n_vertices} * m_bits + 63) / 64} {}
+
+  // Adds a layer with every predecessor 0, layer 0 is the first added.
+  void add_layer() { m_words.resize(m_words.size() + m_words_per_layer); }
+
+  [[nodiscard]] std::size_t n_layers() const {
+    return m_words.size() / m_words_per_layer;
+  }
+
+  [[nodiscard]] std::uint32_t get(std::size_t len, std::uint32_t v) const {
+    const auto [word, offset] = position(len, v);
+    std::uint64_t value = m_words[word] >> offset;
+    if (offset + m_bits > 64) {
+      value |= m_words[word + 1] << (64 - offset);
+    }
+    return static_cast<std::uint32_t>(value & mask());
+  }
+
+  void set(std::size_t len, std::uint32_t v, std::uint32_t pred) {
+    const auto [word, offset] = position(len, v);
+    m_words[word] = (m_words[word] & ~(mask() << offset)) |
+                    (std::uint64_t{pred} << offset);
+    if (offset + m_bits > 64) {
+      const auto spill = 64 - offset;
+      m_words[word + 1] = (m_words[word + 1] & ~(mask() >> spill)) |
+                          (std::uint64_t{pred} >> spill);
+    }
+  }
+
+private:
+  unsigned m_bits;
+  std::size_t m_words_per_layer;
+  std::vector<std::uint64_t> m_words;
+
+  [[nodiscard]] std::uint64_t mask() const {
+    return (std::uint64_t{1} << m_bits) - 1;
+  }
+
+  [[nodiscard]] std::pair<std::size_t, unsigned>
+  position(std::size_t len, std::uint32_t v) const {
+    const auto bit = std::size_t{v} * m_bits;
+    return {len * m_words_per_layer + bit / 64,
+            static_cast<unsigned>(bit % 64)};
+  }
+};
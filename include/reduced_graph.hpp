@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Finds the strongly connected components of a directed graph, with
+ * Tarjan's algorithm. This uses an explicit stack, since slice graphs are too
+ * large for recursion.
+ * @param n The number of vertices
+ * @param adj adj(u) gives the successors of u
+ * @param comp Set to the component of each vertex. Components are numbered in
+ * reverse topological order, so every edge goes to a component with the same
+ * or a smaller number.
+ * @return The number of components
+ */
+template <class adj_t>
+std::uint32_t strongly_connected_components(std::uint32_t n, const adj_t &adj,
+                                            std::vector<std::uint32_t> &comp) {
+  constexpr auto unseen = static_cast<std::uint32_t>(-1);
+
+  std::vector<std::uint32_t> index(n, unseen), low(n), edge(n), stack,
+      call_stack;
+  std::vector<bool> on_stack(n);
+  std::uint32_t counter = 0, n_comps = 0;
+
+  comp.assign(n, unseen);
+  for (std::uint32_t root = 0; root < n; ++root) {
+    if (index[root] != unseen) {
+      continue;
+    }
+
+    call_stack.push_back(root);
+    index[root] = low[root] = counter++;
+    edge[root] = 0;
+    stack.push_back(root);
+    on_stack[root] = true;
+
+    while (!call_stack.empty()) {
+      const auto u = call_stack.back();
+      const auto &out = adj(u);
+
+      if (edge[u] < out.size()) {
+        const std::uint32_t v = out[edge[u]++];
+        if (index[v] == unseen) {
+          index[v] = low[v] = counter++;
+          edge[v] = 0;
+          stack.push_back(v);
+          on_stack[v] = true;
+          call_stack.push_back(v);
+        } else if (on_stack[v]) {
+          low[u] = std::min(low[u], index[v]);
+        }
+        continue;
+      }
+
+      call_stack.pop_back();
+      if (!call_stack.empty()) {
+        low[call_stack.back()] = std::min(low[call_stack.back()], low[u]);
+      }
+
+      if (low[u] == index[u]) {
+        std::uint32_t v;
+        do {
+          v = stack.back();
+          stack.pop_back();
+          on_stack[v] = false;
+          comp[v] = n_comps;
+        } while (v != u);
+        ++n_comps;
+      }
+    }
+  }
+
+  return n_comps;
+}
+
+/**
+ * @brief The part of a slice graph that a search can use. Most vertices of a
+ * slice graph are created for one particular ER, and many of those cannot be
+ * part of what a search looks for: a tile is a cycle, so only vertices in a
+ * strongly connected component with a cycle matter, and a prism of a given
+ * length is a walk with that many vertices, so only vertices with long enough
+ * walks into and out of them matter.
+ *
+ * A reduced graph keeps only the vertices and edges that can matter, numbered
+ * densely, with all adjacency lists in one array. See reduce_for_cycles and
+ * reduce_for_paths.
+ */
+class reduced_graph {
+public:
+  // The vertex of the full graph each vertex came from.
+  std::vector<std::uint32_t> original;
+
+  std::vector<std::uint32_t> weight;
+
+  // The size of the full graph.
+  std::size_t full_vertices = 0, full_edges = 0;
+
+  /**
+   * @brief Copies the vertices and edges of a graph that are kept.
+   * @param n The number of vertices of the full graph
+   * @param full_adj full_adj(u) gives the successors of u
+   * @param full_weight full_weight(u) gives the weight of u
+   * @param keep_vertex keep_vertex(u) is true if u is kept
+   * @param keep_edge keep_edge(u, v) is true if the edge from u to v is kept,
+   * given that both u and v are
+   */
+  template <class adj_t, class weight_t, class keep_vertex_t,
+            class keep_edge_t>
+  reduced_graph(std::uint32_t n, const adj_t &full_adj,
+                const weight_t &full_weight, const keep_vertex_t &keep_vertex,
+                const keep_edge_t &keep_edge)
+      : full_vertices{n} {
+    constexpr auto removed = static_cast<std::uint32_t>(-1);
+
+    std::vector<std::uint32_t> renumber(n, removed);
+    for (std::uint32_t u = 0; u < n; ++u) {
+      if (keep_vertex(u)) {
+        renumber[u] = static_cast<std::uint32_t>(original.size());
+        original.push_back(u);
+        weight.push_back(full_weight(u));
+      }
+    }
+
+    m_offsets.push_back(0);
+    for (std::uint32_t u = 0; u < n; ++u) {
+      full_edges += full_adj(u).size();
+      if (renumber[u] == removed) {
+        continue;
+      }
+
+      for (const std::uint32_t v : full_adj(u)) {
+        if (renumber[v] != removed && keep_edge(u, v)) {
+          m_adj.push_back(renumber[v]);
+        }
+      }
+      m_offsets.push_back(m_adj.size());
+    }
+  }
+
+  [[nodiscard]] std::uint32_t size() const {
+    return static_cast<std::uint32_t>(original.size());
+  }
+
+  [[nodiscard]] std::size_t n_edges() const { return m_adj.size(); }
+
+  [[nodiscard]] std::span<const std::uint32_t>
+  successors(std::uint32_t v) const {
+    return std::span{m_adj}.subspan(m_offsets[v],
+                                    m_offsets[v + 1] - m_offsets[v]);
+  }
+
+  // The predecessors of a vertex in increasing order, these are only
+  // available after build_predecessors.
+  [[nodiscard]] std::span<const std::uint32_t>
+  predecessors(std::uint32_t v) const {
+    return std::span{m_pred}.subspan(m_pred_offsets[v],
+                                     m_pred_offsets[v + 1] - m_pred_offsets[v]);
+  }
+
+  // Fills in the predecessors, for DPs that pull each layer from the last.
+  void build_predecessors() {
+    m_pred_offsets.assign(std::size_t{size()} + 1, 0);
+    for (const auto v : m_adj) {
+      ++m_pred_offsets[v + 1];
+    }
+    std::partial_sum(m_pred_offsets.begin(), m_pred_offsets.end(),
+                     m_pred_offsets.begin());
+
+    std::vector<std::size_t> next(m_pred_offsets.begin(),
+                                  m_pred_offsets.end() - 1);
+    m_pred.resize(m_adj.size());
+    for (std::uint32_t u = 0; u < size(); ++u) {
+      for (const auto v : successors(u)) {
+        m_pred[next[v]++] = u;
+      }
+    }
+  }
+
+private:
+  // The successors of v are m_adj[m_offsets[v]] up to m_adj[m_offsets[v + 1]],
+  // and likewise for the predecessors.
+  std::vector<std::size_t> m_offsets, m_pred_offsets;
+  std::vector<std::uint32_t> m_adj, m_pred;
+};
+
+/**
+ * @brief Keeps only what can be on a cycle, which is the vertices in a
+ * strongly connected component with a cycle, and the edges within each.
+ * @param n The number of vertices
+ * @param adj adj(u) gives the successors of u
+ * @param weight weight(u) gives the weight of u
+ */
+template <class adj_t, class weight_t>
+[[nodiscard]] reduced_graph reduce_for_cycles(std::uint32_t n,
+                                              const adj_t &adj,
+                                              const weight_t &weight) {
+  std::vector<std::uint32_t> comp;
+  const auto n_comps = strongly_connected_components(n, adj, comp);
+
+  // A component has a cycle if it has an edge within it.
+  std::vector<bool> cyclic(n_comps);
+  for (std::uint32_t u = 0; u < n; ++u) {
+    for (const std::uint32_t v : adj(u)) {
+      if (comp[u] == comp[v]) {
+        cyclic[comp[u]] = true;
+      }
+    }
+  }
+
+  return reduced_graph{
+      n, adj, weight, [&](std::uint32_t u) { return cyclic[comp[u]]; },
+      [&](std::uint32_t u, std::uint32_t v) { return comp[u] == comp[v]; }};
+}
+
+/**
+ * @brief Keeps only what can be on a walk with the given number of vertices.
+ * That is every vertex v where the longest walks ending at v and starting from
+ * v have at least length - 1 edges between them. These are found on the graph
+ * of components in topological order, where a component with a cycle has walks
+ * of any length.
+ * @param n The number of vertices
+ * @param adj adj(u) gives the successors of u
+ * @param weight weight(u) gives the weight of u
+ * @param length The number of vertices of the walks, at least 1
+ */
+template <class adj_t, class weight_t>
+[[nodiscard]] reduced_graph reduce_for_paths(std::uint32_t n, const adj_t &adj,
+                                             const weight_t &weight,
+                                             std::uint64_t length) {
+  std::vector<std::uint32_t> comp;
+  const auto n_comps = strongly_connected_components(n, adj, comp);
+
+  std::vector<std::vector<std::uint32_t>> members(n_comps);
+  std::vector<bool> cyclic(n_comps);
+  for (std::uint32_t u = 0; u < n; ++u) {
+    members[comp[u]].push_back(u);
+    for (const std::uint32_t v : adj(u)) {
+      if (comp[u] == comp[v]) {
+        cyclic[comp[u]] = true;
+      }
+    }
+  }
+
+  // Edges needed for a walk of the given length, walks are only measured up
+  // to this.
+  const std::uint64_t needed = length - 1;
+
+  // Edges go from higher to lower numbered components, so the longest walks
+  // out of each vertex are found from the lowest up.
+  std::vector<std::uint64_t> out(n, 0), in(n, 0);
+  for (std::uint32_t c = 0; c < n_comps; ++c) {
+    for (const auto u : members[c]) {
+      if (cyclic[c]) {
+        out[u] = needed;
+        continue;
+      }
+
+      for (const std::uint32_t v : adj(u)) {
+        out[u] = std::max(out[u], std::min(needed, out[v] + 1));
+      }
+    }
+  }
+
+  // And the longest walks into each vertex from the highest down.
+  for (auto c = n_comps; c-- > 0;) {
+    for (const auto u : members[c]) {
+      if (cyclic[c]) {
+        in[u] = needed;
+      }
+
+      for (const std::uint32_t v : adj(u)) {
+        in[v] = std::max(in[v], std::min(needed, in[u] + 1));
+      }
+    }
+  }
+
+  return reduced_graph{
+      n, adj, weight,
+      [&](std::uint32_t u) { return in[u] + out[u] >= needed; },
+      [&](std::uint32_t u, std::uint32_t v) {
+        return in[u] + 1 + out[v] >= needed;
+      }};
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The slice graph of a HRP cross-section, with the dimensions given at
+ * runtime. A slice is an acyclic arrangement of induced vertices in the
+ * cross-section, and a vertex of the graph is a slice along with which of its
+ * components are already connected through earlier slices. An edge means the
+ * second slice can follow the first without creating a cycle.
+ *
+ * Dimensions are in the same order as for hrp_graph, and the slices of a
+ * cross-section are paths through the unpruned graph of all but its last
+ * dimension, so the last dimension varies slowest in the cells of a slice.
+ *
+ * Graphs are built once per set of dimensions and kept for the life of the
+ * program, so building many sizes reuses the lower dimensional graphs they
+ * have in common. They never change for a given cross-section, so each is
+ * also saved to a file in cache_directory once built, and later runs load it
+ * from there instead.
+ */
+class slice_graph {
+public:
+  using comp_num = std::uint8_t;
+
+  // Cells that are not induced. A completely empty cell also has no induced
+  // neighbours within the slice, and a pruned graph has no slices with them.
+  constexpr static comp_num empty_cell = std::numeric_limits<comp_num>::max();
+  constexpr static comp_num completely_empty_cell = empty_cell - 1;
+
+  [[nodiscard]] constexpr static bool is_empty(comp_num c) {
+    return c >= completely_empty_cell;
+  }
+
+  struct slice {
+    std::uint32_t n_induced;
+    comp_num n_comps;
+
+    // The component number of each cell, or one of the empty values. For a
+    // pruned graph, this also has each physically different symmetry after
+    // the first, which is the canonical one.
+    std::vector<std::vector<comp_num>> forms;
+  };
+
+  struct vertex {
+    std::vector<std::uint32_t> adj;
+    std::uint32_t slice_id;
+
+    // The group of each component of the slice, components in the same
+    // group are connected through earlier slices. Groups are numbered in
+    // order of first appearance.
+    std::vector<comp_num> groups;
+  };
+
+  /**
+   * @brief Returns the slice graph of a cross-section, building it (and any
+   * lower dimensional graphs it needs) if this is the first request for it.
+   * @param dims The dimensions of the cross-section
+   * @param prune Whether to prune slices and successors that can never be
+   * part of a maximum induced forest (see optimizations.txt)
+   */
+  [[nodiscard]] static const slice_graph &get(std::span<const std::size_t> dims,
+                                              bool prune);
+
+  [[nodiscard]] const std::vector<std::size_t> &dims() const { return m_dims; }
+  [[nodiscard]] bool pruned() const { return m_prune; }
+  [[nodiscard]] std::size_t n_cells() const { return m_n_cells; }
+
+  [[nodiscard]] const std::vector<slice> &slices() const { return m_slices; }
+  [[nodiscard]] const std::vector<vertex> &vertices() const {
+    return m_vertices;
+  }
+
+  // The first slices().size() vertices are each slice with no components
+  // connected, so they are where a prism starts.
+  [[nodiscard]] const slice &slice_of(std::uint32_t v) const {
+    return m_slices[m_vertices[v].slice_id];
+  }
+
+  [[nodiscard]] std::size_t n_edges() const;
+
+  /**
+   * @brief Finds the symmetry of a vertex's slice that an edge out of it was
+   * found with. Edges are found with the slice after them in its canonical
+   * form, forms[0], and the slice before in whichever of its forms that could
+   * follow with the groups of after.
+   * @param before The vertex the edge starts at
+   * @param after The vertex the edge ends at
+   * @return The index of that form in slice_of(before).forms, or the number of
+   * forms if there is no such edge
+   */
+  [[nodiscard]] std::size_t edge_form(std::uint32_t before,
+                                      std::uint32_t after) const;
+
+  /**
+   * @brief Where built graphs are saved, relative to the working directory.
+   * Graphs are neither saved nor loaded if this is empty.
+   */
+  static inline std::string cache_directory = "cache";
+
+  slice_graph(const slice_graph &) = delete;
+  slice_graph &operator=(const slice_graph &) = delete;
+
+private:
+  // Only sets the dimensions, the graph is then built or loaded by get.
+  slice_graph(std::span<const std::size_t> dims, bool prune);
+
+  std::vector<std::size_t> m_dims;
+  bool m_prune;
+  std::size_t m_n_cells;
+
+  std::vector<slice> m_slices;
+  std::vector<vertex> m_vertices;
+
+  void enumerate_slices();
+  void fill_vertices();
+
+  [[nodiscard]] std::string cache_file() const;
+
+  // Returns false (and leaves the graph empty) if there is no cache file for
+  // this graph, or it is damaged.
+  bool load();
+
+  // Returns true iff the graph was saved.
+  bool save() const;
+};
+
+/**
+ * @brief Finds the maximum number of vertices in an induced forest of a prism,
+ * by the longest walk of a given number of slices through a slice graph.
+ * @param graph The pruned slice graph of the prism's cross-section
+ * @param length The number of slices in the prism
+ * @return The maximum number of induced vertices
+ */
+[[nodiscard]] std::size_t max_prism_forest(const slice_graph &graph,
+                                           std::size_t length);
+
+/**
+ * @brief Finds the maximum induced forest of every prism with a given
+ * cross-section up to some length, with the same walk as max_prism_forest.
+ * @param graph The pruned slice graph of the prisms' cross-section
+ * @param max_length The length of the longest prism
+ * @return The maximum number of induced vertices of the prism of each length,
+ * from 0 to max_length
+ */
+[[nodiscard]] std::vector<std::size_t>
+max_prism_forests(const slice_graph &graph, std::size_t max_length);
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "permutation.hpp"
+#include "predecessor_matrix.hpp"
+#include "slice_graph.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+/**
+ * @brief A path of vertices through a slice graph, which is a prism (or a
+ * tile, if it is a cycle) with the slices of those vertices.
+ *
+ * Each edge of a pruned graph was found with the slice after it in its
+ * canonical form and the slice before it in whichever symmetry could precede
+ * that, so printing every slice in its canonical form would not give a prism
+ * that fits together. Slices are printed in the symmetries the edges were
+ * found with instead: the last in its canonical form, and each before it in
+ * the symmetry that precedes the one printed after it. Each slice is printed
+ * on its own line, one character per cell, 'X' for the induced ones.
+ */
+class slice_path {
+public:
+  // The cell of a slice's canonical form shown in each cell.
+  using cell_map = std::vector<std::uint32_t>;
+
+  slice_path(const slice_graph &graph, std::vector<std::uint32_t> vertices);
+
+  /**
+   * @brief Rebuilds the best path found by a path DP.
+   * @param graph The graph the path goes through
+   * @param preds The predecessors found by the DP
+   * @param len The number of vertices of the path
+   * @param end The last vertex of the path
+   */
+  slice_path(const slice_graph &graph, const predecessor_matrix &preds,
+             std::size_t len, std::uint32_t end);
+
+  [[nodiscard]] const std::vector<std::uint32_t> &vertices() const {
+    return m_vertices;
+  }
+
+  // Replaces each vertex v with original[v], to go from the vertices of a
+  // reduced graph back to those of the slice graph.
+  slice_path &renumber(std::span<const std::uint32_t> original);
+
+  // For a cycle, whose last slice is followed by its first, repeats the
+  // slices until the symmetry the first is printed in is the one that follows
+  // the last, so that copies of the tile fit together end to end.
+  slice_path &close_tile();
+
+  // The symmetry each slice is printed in.
+  [[nodiscard]] std::vector<cell_map> orientations() const;
+
+  friend std::ostream &operator<<(std::ostream &stream, const slice_path &path);
+
+private:
+  const slice_graph *m_graph;
+  std::vector<std::uint32_t> m_vertices;
+
+  // The cell map of the vertex before, given that of after, which follows it.
+  [[nodiscard]] cell_map precede(const permutation_set &perms,
+                                 std::uint32_t before, std::uint32_t after,
+                                 const cell_map &shown) const;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "fraction.hpp"
+#include "slice_graph.hpp"
+#include "slice_path.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief A tile, which is a cycle through a slice graph. Copies of it placed
+ * end to end fill a prism of any length with its cross-section.
+ */
+struct slice_tile {
+  // The number of induced vertices per cell.
+  fraction density;
+  slice_path path;
+};
+
+/**
+ * @brief Finds the tile with the largest density. The density of a tile is
+ * the mean number of induced vertices per slice of a cycle in the slice graph,
+ * so this is a maximum mean cycle (see max_cycle_ratio). Of the tiles as dense
+ * as it, the shortest is returned.
+ * @param graph The pruned slice graph of the tile's cross-section
+ * @return The tile, or nothing if the graph has no cycles
+ */
+[[nodiscard]] std::optional<slice_tile>
+max_density_tile(const slice_graph &graph);
+
+/**
+ * @brief Finds the tile with the largest density with a path DP from every
+ * starting vertex. This is O(V^3), and is kept to check max_density_tile
+ * against. Starts run in parallel, and of tiles as dense and as long, the one
+ * from the lowest start is kept, so the result does not depend on the number
+ * of threads.
+ * @param graph The pruned slice graph of the tile's cross-section
+ * @param bounded If true, the maximum mean cycle is found first, and starts
+ * stop once a tile as dense and no longer than it is found, since none can be
+ * better. Otherwise, the DP does not rely on the cycle ratio search at all,
+ * and every start runs to the end.
+ * @return The tile, or nothing if the graph has no cycles
+ */
+[[nodiscard]] std::optional<slice_tile>
+max_density_tile_by_paths(const slice_graph &graph, bool bounded);
+
+/**
+ * @brief A prism, which is a walk through a slice graph.
+ */
+struct slice_prism {
+  std::size_t n_induced;
+  slice_path path;
+};
+
+/**
+ * @brief Finds the prism of a given length with the most induced vertices, as
+ * with max_prism_forest, along with the prism itself. Only the part of the
+ * graph on walks of that length is searched, and each layer of the DP is
+ * split between threads. The slices of the pruned graph are already orbits
+ * under the symmetries of the cross-section, so each vertex stands for all the
+ * (slice, groups) states equivalent to it.
+ * @param graph The pruned slice graph of the prism's cross-section
+ * @param length The number of slices in the prism
+ */
+[[nodiscard]] slice_prism max_prism(const slice_graph &graph,
+                                    std::size_t length);
+
+/**
+ * @brief Finds the number of induced vertices of the largest prism of a given
+ * length with a power of the max-plus transfer matrix of the slice graph. This
+ * takes O(log length) matrix products, so can reach lengths far past what
+ * max_prism can, but does not find the prism.
+ * @param graph The pruned slice graph of the prism's cross-section
+ * @param length The number of slices in the prism
+ * @return The number of induced vertices, or nothing if that could be too
+ * large for a max_plus_matrix
+ */
+[[nodiscard]] std::optional<std::size_t>
+max_prism_by_power(const slice_graph &graph, std::uint64_t length);
+
+/**
+ * @brief Where the maximum for each length of prism becomes periodic. The
+ * maximum for length start + k * period + r is the maximum for start + r plus
+ * k * gain, for every k and r. The period is the shortest there is, and start
+ * is the first length that holds from.
+ */
+struct prism_period {
+  std::size_t start, period, gain;
+};
+
+/**
+ * @brief Finds where the maximum for each length becomes periodic, by running
+ * the layer by layer DP until a layer is the same as an earlier one plus a
+ * constant. Every later layer then repeats too, and so does the maximum, but
+ * the maximum can repeat sooner than the layers and with a shorter period, so
+ * both are then searched back for. This uses the full slice graph, since
+ * vertices only on short walks still change where the maximum becomes
+ * periodic.
+ * @param graph The pruned slice graph of the prisms' cross-section
+ * @param max_length The most lengths to try
+ * @return The period, or nothing if none was found up to max_length
+ */
+[[nodiscard]] std::optional<prism_period>
+find_prism_period(const slice_graph &graph, std::size_t max_length);
+
+/**
+ * @brief Finds the largest induced tree of every prism with a given
+ * cross-section up to some length.
+ *
+ * The slice graph only keeps induced vertices acyclic, so a walk through it
+ * can be a forest with any number of components. To find the largest induced
+ * tree, this DP also tracks whether the tree has started, is still open or is
+ * finished, and only lets a component end when it is the whole tree.
+ *
+ * The groups of a vertex say which of its components are already connected
+ * through earlier slices. Going to a successor, a group which touches none of
+ * the successor's induced cells can never be connected to anything again. If
+ * it is the only group the tree is finished, and every later slice must be
+ * empty, otherwise it would be a second component.
+ * @param graph The unpruned slice graph of the prisms' cross-section. Every
+ * arrangement of induced vertices is needed here, including empty slices and
+ * ones that are dominated for forests.
+ * @param max_length The length of the longest prism
+ * @return The number of vertices of the largest induced tree of the prism of
+ * each length, from 0 to max_length
+ */
+[[nodiscard]] std::vector<std::size_t>
+max_prism_trees(const slice_graph &graph, std::size_t max_length);
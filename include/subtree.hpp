@@ -2,6 +2,7 @@
 
 #include "concepts.hpp"
 #include "graph.hpp"
+#include "implicit_graph.hpp"
 #include "permutation.hpp"
 #include "static_graph.hpp"
 
@@ -11,9 +12,26 @@
 #include <array>
 #include <cassert>
 #include <concepts>
+#include <cstdint>
 #include <span>
 #include <vector>
 
+/**
+ * @brief Gets the Zobrist key of a vertex. The hash of a set of vertices is the
+ * XOR of the keys of its members, so it does not depend on the order they were
+ * added in. Keys are a fixed function of the vertex ID, so hashes are
+ * reproducible between runs.
+ * @param id The vertex to get the key of
+ * @return The key of the vertex
+ */
+[[nodiscard]] constexpr std::uint64_t zobrist_key(std::uint64_t id) {
+  // SplitMix64 finalizer
+  id += 0x9e3779b97f4a7c15;
+  id = (id ^ (id >> 30)) * 0xbf58476d1ce4e5b9;
+  id = (id ^ (id >> 27)) * 0x94d049bb133111eb;
+  return id ^ (id >> 31);
+}
+
 // Each index is either enabled or disabled, and includes its
 // effective degree (which is cnt)
 template <class graph_t> struct subtree_vertex {
@@ -48,13 +66,28 @@ template <std::size_t... dims> struct vertices_base<static_hrp_graph<dims...>> {
   operator<=>(const vertices_base &) const = default;
 };
 
+// How a subtree refers to the vertices of its base graph: a span of them, or a
+// copy of the range that computes them for an implicit graph.
+template <class graph_t> struct base_vertices {
+  using type = std::span<const typename graph_t::vertex>;
+};
+
+template <> struct base_vertices<implicit_hrp_graph> {
+  using type = implicit_hrp_graph::vertex_range;
+};
+
+template <class graph_t>
+using base_vertices_t = typename base_vertices<graph_t>::type;
+
 // Represents an induced subtree
 template <class graph_t> class subtree : public vertices_base<graph_t> {
   graph_t::vertex_id n_induced_;
 
   graph_t::vertex_id root_;
 
-  std::span<const typename graph_t::vertex> base_graph_verts;
+  std::uint64_t hash_{0};
+
+  base_vertices_t<graph_t> base_graph_verts;
 
 public:
   /**
@@ -67,14 +100,15 @@ public:
       : vertices_base<graph_t>(base.vertices.size()), n_induced_{0},
         root_{graph_t::no_vertex}, base_graph_verts{base.vertices} {}
 
-  subtree(const std::span<const typename graph_t::vertex> base_verts)
+  subtree(const base_vertices_t<graph_t> base_verts)
       : vertices_base<graph_t>(base_verts.size()),
         n_induced_{0}, root_{graph_t::no_vertex}, base_graph_verts{base_verts} {
   }
 
   subtree(const graph_t &base, graph_t::vertex_id root_id)
       : vertices_base<graph_t>(base.vertices.size()),
-        n_induced_{1}, root_{root_id}, base_graph_verts{base.vertices} {
+        n_induced_{1}, root_{root_id}, hash_{zobrist_key(root_id)},
+        base_graph_verts{base.vertices} {
     vertices_base<graph_t>::vertices[root_].induced = true;
 
     for (const auto neighbor : base_graph_verts[root_].neighbors)
@@ -94,7 +128,7 @@ public:
   }
 
   // Returns the base graph
-  const std::span<const typename graph_t::vertex> base_verts() const {
+  const base_vertices_t<graph_t> base_verts() const {
     return base_graph_verts;
   }
 
@@ -122,6 +156,9 @@ public:
   // Returns the number of induced vertices.
   graph_t::vertex_id n_induced() const { return n_induced_; }
 
+  // Returns the Zobrist hash of the set of induced vertices.
+  std::uint64_t hash() const { return hash_; }
+
   // Adds i to the current subtree.
   // Assumes i is on the border of the current graph.
   // Currently, does not check for enclosed space.
@@ -130,6 +167,7 @@ public:
 
     vertices_base<graph_t>::vertices[i].induced = true;
     ++n_induced_;
+    hash_ ^= zobrist_key(i);
 
     for (const auto neighbor : base_graph_verts[i].neighbors) {
       ++vertices_base<graph_t>::vertices[neighbor].effective_degree;
@@ -145,6 +183,7 @@ public:
 
     vertices_base<graph_t>::vertices[i].induced = false;
     --n_induced_;
+    hash_ ^= zobrist_key(i);
 
     for (const auto neighbor : base_graph_verts[i].neighbors)
       --vertices_base<graph_t>::vertices[neighbor].effective_degree;
@@ -162,6 +201,9 @@ public:
     result.n_induced_ = n_induced_;
     for (std::size_t i = 0; i < this->vertices.size(); ++i) {
       result.vertices[perm[i]] = this->vertices[i];
+      if (this->vertices[i].induced) {
+        result.hash_ ^= zobrist_key(perm[i]);
+      }
     }
     return result;
   }
@@ -196,7 +238,7 @@ private:
     if constexpr (std::unsigned_integral<typename graph_t::vertex_id>) {
       assert(0 <= i);
     }
-    assert(i < base_graph.vertices.size());
+    assert(i < base_graph_verts.size());
   }
 
   // Assuming i has one neighbor, returns the ID of that neighbor.
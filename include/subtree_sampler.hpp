@@ -0,0 +1,119 @@
+#pragma once
+
+#include "config.hpp"
+#include "parallel_for.hpp"
+#include "subtree_zdd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Draws induced subtrees uniformly at random from a subtree ZDD, either
+ * from all of them, including the empty one, or from those of one size.
+ *
+ * Each node is weighed by the number of paths from it to the top terminal (of
+ * each remaining size, if the size is fixed), so a walk from the root that
+ * takes each edge in proportion to the weight behind it reaches every subtree
+ * with the same probability. Weights are doubles, which hold counts for graphs
+ * of up to 1023 vertices, and the rounding of their ratios is far below
+ * anything sampling could detect. With a fixed size, a node has a weight for
+ * each remaining size it can be reached with and still complete.
+ *
+ * The walk only needs, for each node and remaining size it can reach, the
+ * vertex, where each edge leads, and the chance of the hi edge, so these are
+ * packed into one table, and steps that always take the lo edge are skipped.
+ * The sampler does not refer to the diagram once built.
+ */
+class subtree_sampler {
+public:
+  /**
+   * @brief Prepares to draw from every subtree of a diagram.
+   * @param zdd The diagram to draw from
+   */
+  explicit subtree_sampler(const subtree_zdd &zdd);
+
+  /**
+   * @brief Prepares to draw from the subtrees of a diagram with a given number
+   * of induced vertices.
+   * @param zdd The diagram to draw from
+   * @param size The number of induced vertices, at most zdd.max_size()
+   */
+  subtree_sampler(const subtree_zdd &zdd, vertex_id size);
+
+  /**
+   * @brief Draws one subtree.
+   * @param rng The source of randomness
+   * @param induced Has the induced vertices appended, in increasing order
+   */
+  void draw(std::mt19937_64 &rng, std::vector<vertex_id> &induced) const;
+
+  /**
+   * @brief Draws several subtrees at once. Their walks are taken a step at a
+   * time in turn, so the table lookups of each overlap the others'.
+   * @param rng The source of randomness
+   * @param induced Has the induced vertices of each subtree assigned, in
+   * increasing order
+   */
+  void draw(std::mt19937_64 &rng,
+            std::span<std::vector<vertex_id>> induced) const;
+
+  /**
+   * @brief Draws a number of subtrees in parallel. Samples are drawn in fixed
+   * blocks, each with its own generator seeded from the seed and the block, so
+   * the samples are the same however many threads draw them.
+   * @param n The number of subtrees to draw
+   * @param seed The seed
+   * @param action Invoked with the index of each sample, and its induced
+   * vertices in increasing order. Will be invoked concurrently, so must be
+   * thread-safe.
+   * @param n_threads The number of threads to draw with
+   */
+  template <std::invocable<std::size_t, std::span<const vertex_id>> TAction>
+  void sample(std::size_t n, std::uint64_t seed, TAction &&action,
+              unsigned n_threads = std::thread::hardware_concurrency()) const {
+    constexpr std::size_t block_size = 4096;
+    parallel_for(
+        (n + block_size - 1) / block_size,
+        [&](std::size_t block) {
+          std::mt19937_64 rng{seed ^ zobrist_key(block)};
+          std::array<std::vector<vertex_id>, n_interleaved> induced;
+          const auto end = std::min(n, (block + 1) * block_size);
+          for (auto i = block * block_size; i < end; i += n_interleaved) {
+            const auto n_drawn = std::min(n_interleaved, end - i);
+            draw(rng, std::span{induced}.first(n_drawn));
+            for (std::size_t j = 0; j < n_drawn; ++j) {
+              action(i + j, std::span<const vertex_id>{induced[j]});
+            }
+          }
+        },
+        n_threads);
+  }
+
+private:
+  subtree_sampler(const subtree_zdd &zdd, std::optional<vertex_id> size);
+
+  struct step {
+    vertex_id var;
+    // The steps each edge leads to.
+    std::uint32_t lo, hi;
+    // The hi edge is taken if a random 64 bit number is below this, or always
+    // if it is the largest.
+    std::uint64_t threshold;
+  };
+
+  // How many subtrees sample draws at once.
+  constexpr static std::size_t n_interleaved = 16;
+
+  // The step reached once a subtree is complete.
+  constexpr static std::uint32_t done = 0;
+
+  std::vector<step> m_steps;
+  std::uint32_t m_first;
+};
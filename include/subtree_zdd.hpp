@@ -0,0 +1,80 @@
+#pragma once
+
+#include "big_uint.hpp"
+#include "config.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A zero-suppressed decision diagram (ZDD) of every induced subtree of
+ * a graph, including the empty one. Each node decides one vertex: its hi edge
+ * induces it, and its lo edge does not. Every path to the top terminal is a
+ * subtree, with every vertex after the last node on it not induced.
+ *
+ * The diagram is built frontier by frontier, as in Knuth's "simpath".
+ * Vertices are decided in order of ID, so the only decided vertices that
+ * later ones can touch are the last cross-section's worth (all but the last
+ * dimension), the frontier. The state of a partial subtree is which of those
+ * are induced, and which of those are already connected. Partial subtrees with
+ * the same state have the same completions, so they share a node, found
+ * through a unique table for each vertex. The states after each vertex are
+ * found in parallel. The diagram is then reduced: nodes with the same edges
+ * are merged, and nodes whose hi edge rejects are skipped.
+ *
+ * The number of states grows with the size of the frontier, so the largest
+ * dimension should be last.
+ */
+class subtree_zdd {
+public:
+  using node_id = std::uint32_t;
+
+  constexpr static node_id reject = 0;
+  constexpr static node_id accept = 1;
+
+  struct node {
+    // The vertex decided, the number of vertices for the terminals.
+    vertex_id var;
+    node_id lo, hi;
+  };
+
+  /**
+   * @brief Builds the diagram of a graph.
+   * @param graph The graph, which must outlive the diagram. Its cross-section
+   * must have fewer than 255 vertices.
+   * @param n_threads The number of threads to find states with
+   * @throws std::length_error If a vertex has more states, or the diagram has
+   * more nodes, than a node_id can number
+   */
+  explicit subtree_zdd(const graph_type &graph,
+                       unsigned n_threads = std::thread::hardware_concurrency());
+
+  // Includes the terminals, which are the first two nodes. Every node's edges
+  // lead to nodes with lower IDs.
+  [[nodiscard]] const std::vector<node> &nodes() const { return m_nodes; }
+  [[nodiscard]] node_id root() const { return m_root; }
+
+  /**
+   * @brief Counts the subtrees of each size.
+   * @return The number of subtrees with each number of induced vertices, up to
+   * the largest
+   */
+  [[nodiscard]] std::vector<big_uint> count_by_size() const;
+
+  [[nodiscard]] vertex_id max_size() const;
+
+  /**
+   * @brief Gets one of the largest subtrees.
+   */
+  [[nodiscard]] subtree_type max_subtree() const;
+
+private:
+  const graph_type &m_graph;
+
+  std::vector<node> m_nodes;
+  node_id m_root;
+
+  // The size of the largest subtree through each node, -1 if there are none.
+  [[nodiscard]] std::vector<std::int32_t> max_sizes() const;
+};
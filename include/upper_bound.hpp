@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Upper bounds on the maximum induced tree of every box that fits in a
+ * HRP. An induced tree is also an induced forest, and cutting a box in two cuts
+ * any induced forest of it into an induced forest of each part. So the bound of
+ * a box is the least of its maximum induced forest, where its cross-section is
+ * small enough to find that with a slice graph, and the sum of the bounds of
+ * the two parts of each way of cutting it.
+ *
+ * The bound of every box is found when the table is built, so looking one up
+ * is cheap enough for a search to do at every node, for the region it has not
+ * yet explored.
+ */
+class upper_bound_table {
+public:
+  /**
+   * @brief Finds the bounds of every box up to the given dimensions.
+   * @param dims The dimensions of the largest box, in the same order as for
+   * hrp_graph
+   * @param max_slice_cells The most cells a cross-section can have for its
+   * slice graph to be built. Larger is tighter, but the graphs grow very
+   * quickly: 12 cells takes under a second, 15 about a minute. Lines, whose
+   * cross-section is one cell, are always solved, even if this is 0.
+   */
+  upper_bound_table(std::span<const std::size_t> dims,
+                    std::size_t max_slice_cells);
+
+  [[nodiscard]] const std::vector<std::size_t> &dims() const { return m_dims; }
+
+  /**
+   * @brief Gets the bound of a box.
+   * @param box The dimensions of the box, each no larger than the same
+   * dimension of the table. A box with a dimension of 0 has a bound of 0.
+   * @return The most vertices an induced tree of the box can have
+   */
+  [[nodiscard]] std::size_t operator()(std::span<const std::size_t> box) const {
+    return m_bounds[index(box)];
+  }
+
+  /**
+   * @brief Gets the boxes a box was cut into for its bound, the sum of whose
+   * maximum induced forests is its bound.
+   * @param box The dimensions of the box, as for operator()
+   * @return The dimensions of each part
+   */
+  [[nodiscard]] std::vector<std::vector<std::size_t>>
+  slabs(std::span<const std::size_t> box) const;
+
+private:
+  // Where a box was cut for its bound, the dimension is no_cut if it was not.
+  struct cut {
+    constexpr static std::uint8_t no_cut = 0xFF;
+
+    std::uint8_t dim{no_cut};
+    std::size_t at{0};
+  };
+
+  std::vector<std::size_t> m_dims;
+
+  // Boxes are indexed in mixed radix, with one more possible size than the
+  // table has in each dimension, as 0 is a size too.
+  std::vector<std::size_t> m_strides;
+
+  std::vector<std::size_t> m_bounds;
+  std::vector<cut> m_cuts;
+
+  [[nodiscard]] std::size_t index(std::span<const std::size_t> box) const;
+};
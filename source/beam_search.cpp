@@ -0,0 +1,319 @@
+#include "beam_search.hpp"
+#include "border.hpp"
+#include "parallel_for.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <compare>
+#include <concepts>
+#include <mutex>
+#include <random>
+#include <unordered_set>
+
+namespace {
+
+// How often the deepest tree so far is passed to the sink.
+constexpr auto report_interval = std::chrono::seconds{1};
+
+// A partial tree in the beam, along with the vertices that could be added to
+// it. The border is maintained with the same update as the enumerator, so
+// every tree only grows with vertices larger than its root.
+template <class graph_t> struct beam_node {
+  subtree<graph_t> sub;
+  border_type border;
+};
+
+// A possible extension of a partial tree, by one vertex.
+struct candidate {
+  std::uint32_t parent;
+  vertex_id id;
+  std::uint64_t hash;
+  // Higher is better
+  std::size_t score;
+};
+
+// Computes the size of the border of a node after adding a vertex, without
+// modifying the node.
+template <class graph_t>
+std::size_t border_size_after(const beam_node<graph_t> &node, vertex_id id) {
+  std::size_t size = node.border.size() - 1;
+  for (const auto neighbor : node.sub.base_verts()[id].neighbors) {
+    if (node.border.contains(neighbor)) {
+      // This would now have two induced neighbors
+      --size;
+    } else if (node.sub.cnt(neighbor) == 0 && !node.sub.has(neighbor) &&
+               neighbor > node.sub.root()) {
+      ++size;
+    }
+  }
+  return size;
+}
+
+// Adds a vertex from the border of a node to it.
+template <class graph_t>
+void extend(beam_node<graph_t> &node, vertex_id id, history_type &history) {
+  node.border.remove(id);
+  node.sub.add(id);
+  update(node.sub, node.border, id, history);
+}
+
+// Keeps the best `count` candidates, from best to worst, skipping any that
+// produce the same vertex set as a better one or that `keep` rejects. `keep` is
+// only called on candidates that could be kept, from best to worst. Only the
+// candidates looked at are put in order, by taking them from a heap. Ties are
+// broken deterministically, so the result does not depend on the order the
+// candidates were generated in.
+template <std::predicate<const candidate &> TKeep>
+void select_best(std::vector<candidate> &candidates, std::size_t count,
+                 TKeep &&keep) {
+  // The heap's top is the greatest, so this orders better candidates after
+  // worse ones.
+  const auto worse = [](const candidate &a, const candidate &b) {
+    if (a.score != b.score) {
+      return a.score < b.score;
+    }
+    return std::tie(a.hash, a.parent, a.id) > std::tie(b.hash, b.parent, b.id);
+  };
+  std::ranges::make_heap(candidates, worse);
+
+  std::vector<candidate> kept;
+  std::unordered_set<std::uint64_t> seen;
+  for (auto end = candidates.end();
+       kept.size() < count && end != candidates.begin(); --end) {
+    std::ranges::pop_heap(candidates.begin(), end, worse);
+    const auto &c = *(end - 1);
+    if (seen.insert(c.hash).second && keep(c)) {
+      kept.push_back(c);
+    }
+  }
+  candidates = std::move(kept);
+}
+
+void select_best(std::vector<candidate> &candidates, std::size_t count) {
+  select_best(candidates, count, [](const candidate &) { return true; });
+}
+
+// Keeps track of the largest tree without enclosed space found by any thread.
+// Trees of the same size are ordered by hash, then by vertex set, so which one
+// is kept does not depend on the order threads offer them in.
+template <class graph_t> class best_tracker {
+public:
+  explicit best_tracker(const graph_t &graph) : m_graph{graph}, m_best{graph} {}
+
+  // Offers a tree, which is checked for enclosed space unless it is known not
+  // to have any.
+  void offer(const subtree<graph_t> &sub, bool known_open) {
+    // Smaller trees can never be kept, so they are passed over without
+    // locking or searching for enclosed space.
+    if (sub.n_induced() < m_best_size ||
+        (!known_open && has_enclosed_space(m_graph, sub))) {
+      return;
+    }
+
+    std::scoped_lock lock{m_mutex};
+    if (sub.n_induced() != m_best.n_induced()
+            ? sub.n_induced() > m_best.n_induced()
+            : sub.hash() != m_best.hash() ? sub.hash() < m_best.hash()
+                                          : std::is_lt(sub <=> m_best)) {
+      m_best = sub;
+      m_best_size = sub.n_induced();
+    }
+  }
+
+  subtree<graph_t> take() { return std::move(m_best); }
+
+private:
+  const graph_t &m_graph;
+  std::mutex m_mutex;
+  subtree<graph_t> m_best;
+  std::atomic<vertex_id> m_best_size{0};
+};
+
+// Randomly adds vertices to a node until it cannot grow any more, then returns
+// the size of the result. Every result is offered as the best, and any that
+// may beat the sink's is reported to it. Playouts may enclose space, in which
+// case neither keeps the result, but its size still scores the candidate.
+template <class graph_t>
+vertex_id random_playout(beam_node<graph_t> node, std::mt19937_64 &rng,
+                         basic_candidate_sink<graph_t> &sink,
+                         best_tracker<graph_t> &best) {
+  history_type history;
+  while (!node.border.empty()) {
+    auto it = node.border.begin();
+    for (auto skip = std::uniform_int_distribution<vertex_id>{
+             0, node.border.size() - 1}(rng);
+         skip > 0; --skip) {
+      ++it;
+    }
+    extend(node, *it, history);
+  }
+
+  best.offer(node.sub, false);
+  if (node.sub.n_induced() > sink.largest()) {
+    sink.check(node.sub);
+  }
+
+  return node.sub.n_induced();
+}
+
+} // namespace
+
+template <class graph_t>
+subtree<graph_t> beam_search(const graph_t &graph,
+                             const beam_search_options &options,
+                             basic_candidate_sink<graph_t> &sink) {
+  const auto n_vertices = static_cast<vertex_id>(graph.vertices.size());
+
+  best_tracker<graph_t> best{graph};
+
+  // Trees in the beam never enclose space, as any tree that did would only
+  // ever grow into more that do.
+  const subtree<graph_t> empty{graph};
+  const auto root_is_open = [&](const candidate &c) {
+    return !encloses_space_by_adding(graph, empty, c.id);
+  };
+  std::vector<beam_node<graph_t>> beam;
+  const auto is_open = [&](const candidate &c) {
+    return !encloses_space_by_adding(graph, beam[c.parent].sub, c.id);
+  };
+
+  // The roots are scored the same way as any other candidate, by the size of
+  // their border.
+  std::vector<candidate> candidates;
+  candidates.reserve(n_vertices);
+  for (vertex_id id = 0; id < n_vertices; ++id) {
+    const auto &neighbors = graph.vertices[id].neighbors;
+    candidates.push_back({
+        .parent = 0,
+        .id = id,
+        .hash = zobrist_key(id),
+        .score = static_cast<std::size_t>(
+            std::ranges::count_if(neighbors, [id](auto n) { return n > id; })),
+    });
+  }
+  select_best(candidates, options.width, root_is_open);
+
+  beam.reserve(candidates.size());
+  for (const auto &c : candidates) {
+    beam_node<graph_t> node{subtree<graph_t>{graph, c.id},
+                            border_type{n_vertices}};
+    history_type history;
+    update(node.sub, node.border, c.id, history);
+    beam.push_back(std::move(node));
+  }
+
+  // Each depth's trees are one vertex larger than the last's, so only the
+  // last depth's best is offered as the best. Checking and writing a tree
+  // takes time proportional to the graph, so the sink is only given one
+  // about once a second while the search runs.
+  auto last_report = std::chrono::steady_clock::now();
+  const auto report = [&](const beam_node<graph_t> &node) {
+    if (node.sub.n_induced() > sink.largest()) {
+      sink.check(node.sub);
+    }
+    last_report = std::chrono::steady_clock::now();
+  };
+
+  for (std::uint64_t depth = 1; !beam.empty(); ++depth) {
+    if (std::chrono::steady_clock::now() - last_report >= report_interval) {
+      report(beam.front());
+    }
+
+    // Find every way to extend every tree in the beam.
+    std::vector<std::vector<candidate>> per_parent(beam.size());
+    parallel_for(
+        beam.size(),
+        [&](std::size_t p) {
+          const auto &node = beam[p];
+          auto &out = per_parent[p];
+          out.reserve(node.border.size());
+          for (const auto id : node.border) {
+            out.push_back({
+                .parent = static_cast<std::uint32_t>(p),
+                .id = id,
+                .hash = node.sub.hash() ^ zobrist_key(id),
+                .score = border_size_after(node, id),
+            });
+          }
+        },
+        options.n_threads);
+
+    candidates.clear();
+    for (const auto &out : per_parent) {
+      candidates.insert(candidates.end(), out.begin(), out.end());
+    }
+
+    if (options.n_playouts > 0) {
+      // Playouts are expensive, so only the most promising candidates by
+      // border size get them. The border size is kept as a tie breaker.
+      select_best(candidates, 2 * options.width, is_open);
+
+      parallel_for(
+          candidates.size(),
+          [&](std::size_t i) {
+            auto &c = candidates[i];
+            std::mt19937_64 rng{options.seed ^ zobrist_key(c.hash + depth)};
+
+            beam_node<graph_t> child{beam[c.parent]};
+            history_type history;
+            extend(child, c.id, history);
+
+            vertex_id best_playout = 0;
+            for (std::size_t k = 0; k < options.n_playouts; ++k) {
+              best_playout = std::max(best_playout,
+                                      random_playout(child, rng, sink, best));
+            }
+            c.score = best_playout * (std::size_t{n_vertices} + 1) + c.score;
+          },
+          options.n_threads);
+
+      select_best(candidates, options.width);
+    } else {
+      select_best(candidates, options.width, is_open);
+    }
+
+    if (candidates.empty()) {
+      best.offer(beam.front().sub, true);
+      report(beam.front());
+      break;
+    }
+
+    // Each tree is moved to the last of its extensions that is kept, and only
+    // copied for the others, so a tree with one extension costs nothing.
+    std::vector<std::size_t> last_child(beam.size(), candidates.size());
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+      last_child[candidates[i].parent] = i;
+    }
+
+    std::vector<beam_node<graph_t>> next;
+    next.reserve(candidates.size());
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+      auto &parent = beam[candidates[i].parent];
+      if (last_child[candidates[i].parent] == i) {
+        next.push_back(std::move(parent));
+      } else {
+        next.push_back(parent);
+      }
+    }
+
+    parallel_for(
+        next.size(),
+        [&](std::size_t i) {
+          history_type history;
+          extend(next[i], candidates[i].id, history);
+        },
+        options.n_threads);
+
+    beam = std::move(next);
+  }
+
+  return best.take();
+}
+
+template subtree<hrp_graph> beam_search(const hrp_graph &,
+                                        const beam_search_options &,
+                                        basic_candidate_sink<hrp_graph> &);
+template subtree<implicit_hrp_graph>
+beam_search(const implicit_hrp_graph &, const beam_search_options &,
+            basic_candidate_sink<implicit_hrp_graph> &);
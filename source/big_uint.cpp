@@ -0,0 +1,74 @@
+#include "big_uint.hpp"
+
+#include <iterator>
+
+big_uint::big_uint(std::uint64_t value) {
+  for (; value != 0; value >>= 32) {
+    m_limbs.push_back(static_cast<std::uint32_t>(value));
+  }
+}
+
+big_uint::big_uint(std::span<const std::uint32_t> limbs)
+    : m_limbs(limbs.begin(), limbs.end()) {
+  while (!m_limbs.empty() && m_limbs.back() == 0) {
+    m_limbs.pop_back();
+  }
+}
+
+big_uint &big_uint::operator+=(const big_uint &other) {
+  if (m_limbs.size() < other.m_limbs.size()) {
+    m_limbs.resize(other.m_limbs.size());
+  }
+
+  std::uint64_t carry = 0;
+  for (std::size_t i = 0; i < m_limbs.size(); ++i) {
+    if (i >= other.m_limbs.size() && carry == 0) {
+      break;
+    }
+
+    carry += m_limbs[i];
+    if (i < other.m_limbs.size()) {
+      carry += other.m_limbs[i];
+    }
+    m_limbs[i] = static_cast<std::uint32_t>(carry);
+    carry >>= 32;
+  }
+
+  if (carry != 0) {
+    m_limbs.push_back(static_cast<std::uint32_t>(carry));
+  }
+  return *this;
+}
+
+std::string big_uint::to_string() const {
+  if (m_limbs.empty()) {
+    return "0";
+  }
+
+  // Divide by 10^9 repeatedly, each remainder is 9 digits of the result,
+  // least significant first.
+  constexpr std::uint32_t chunk = 1'000'000'000;
+  std::vector<std::uint32_t> quotient = m_limbs;
+  std::vector<std::uint32_t> chunks;
+  while (!quotient.empty()) {
+    std::uint64_t remainder = 0;
+    for (auto limb = quotient.rbegin(); limb != quotient.rend(); ++limb) {
+      const std::uint64_t value = (remainder << 32) | *limb;
+      *limb = static_cast<std::uint32_t>(value / chunk);
+      remainder = value % chunk;
+    }
+    chunks.push_back(static_cast<std::uint32_t>(remainder));
+
+    while (!quotient.empty() && quotient.back() == 0) {
+      quotient.pop_back();
+    }
+  }
+
+  std::string result = std::to_string(chunks.back());
+  for (auto c = std::next(chunks.rbegin()); c != chunks.rend(); ++c) {
+    const auto digits = std::to_string(*c);
+    result.append(9 - digits.size(), '0');
+    result += digits;
+  }
+  return result;
+}
@@ -1,8 +1,9 @@
 #include "border.hpp"
 #include <cassert>
 
-void update(const subtree_type &sub, border_type &border, const vertex_id id,
-            history_type &history) {
+template <class graph_t>
+void update(const subtree<graph_t> &sub, border_type &border,
+            const vertex_id id, history_type &history) {
   /*
   for each neighborhood node y of x do // increasing ordering of y's ID
     if cnt(S, y) > 1 then
@@ -30,6 +31,11 @@ void update(const subtree_type &sub, border_type &border, const vertex_id id,
   }
 }
 
+template void update(const subtree<hrp_graph> &, border_type &, vertex_id,
+                     history_type &);
+template void update(const subtree<implicit_hrp_graph> &, border_type &,
+                     vertex_id, history_type &);
+
 void restore(border_type &border, history_type &history) {
   /*
   while true do
@@ -0,0 +1,260 @@
+#include "candidate.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <unordered_set>
+#include <utility>
+
+template <class graph_t>
+bool has_enclosed_space(const graph_t &graph, const subtree<graph_t> &sub) {
+  // Search outwards from every non-induced vertex on the outer shell, anything
+  // not reached (and not induced) is enclosed.
+  std::vector<bool> reached(graph.vertices.size());
+  std::queue<vertex_id> to_visit;
+
+  for (vertex_id id = 0; id < graph.vertices.size(); ++id) {
+    if (graph.is_on_outer_shell(id) && !sub.has(id)) {
+      reached[id] = true;
+      to_visit.push(id);
+    }
+  }
+
+  vertex_id n_reached = static_cast<vertex_id>(to_visit.size());
+  while (!to_visit.empty()) {
+    const auto id = to_visit.front();
+    to_visit.pop();
+
+    for (const auto neighbor : graph.vertices[id].neighbors) {
+      if (!reached[neighbor] && !sub.has(neighbor)) {
+        reached[neighbor] = true;
+        ++n_reached;
+        to_visit.push(neighbor);
+      }
+    }
+  }
+
+  return sub.n_induced() + n_reached != graph.vertices.size();
+}
+
+template <class graph_t>
+bool encloses_space_by_adding(const graph_t &graph, const subtree<graph_t> &sub,
+                              vertex_id id) {
+  const auto n_dims = graph.dims_array.size();
+
+  // The cells within one step of id in every dimension, indexed by their
+  // offset from it in base 3 (0 behind, 1 level, 2 ahead), with no_vertex
+  // where that is outside the graph.
+  std::size_t n_box = 1;
+  for (std::size_t d = 0; d < n_dims; ++d) {
+    n_box *= 3;
+  }
+  std::vector<vertex_id> box(n_box, id);
+  for (std::size_t d = 0, stride = 1; d < n_dims; ++d, stride *= 3) {
+    for (std::size_t i = 0; i < n_box; ++i) {
+      const auto digit = (i / stride) % 3;
+      if (box[i] != graph_t::no_vertex && digit != 1) {
+        box[i] = (digit == 0) ? graph.backward(d, box[i])
+                              : graph.forward(d, box[i]);
+      }
+    }
+  }
+
+  const auto center = n_box / 2;
+  const auto is_free = [&](std::size_t i) {
+    return i != center && box[i] != graph_t::no_vertex && !sub.has(box[i]);
+  };
+
+  // Groups the free neighbors of id by which of them are connected within the
+  // box, noting which groups touch the outer shell there.
+  std::vector<std::size_t> group(n_box, n_box);
+  std::vector<bool> group_on_shell;
+  std::vector<std::size_t> seeds;
+  std::vector<std::size_t> to_visit;
+  for (std::size_t d = 0, stride = 1; d < n_dims; ++d, stride *= 3) {
+    for (const auto start : {center - stride, center + stride}) {
+      if (!is_free(start) || group[start] != n_box) {
+        continue;
+      }
+
+      const auto g = group_on_shell.size();
+      group_on_shell.push_back(false);
+      seeds.push_back(start);
+      group[start] = g;
+      to_visit.push_back(start);
+      while (!to_visit.empty()) {
+        const auto i = to_visit.back();
+        to_visit.pop_back();
+        if (graph.is_on_outer_shell(box[i])) {
+          group_on_shell[g] = true;
+        }
+
+        for (std::size_t e = 0, step = 1; e < n_dims; ++e, step *= 3) {
+          const auto digit = (i / step) % 3;
+          for (const auto next : {digit > 0 ? i - step : n_box,
+                                  digit < 2 ? i + step : n_box}) {
+            if (next != n_box && is_free(next) && group[next] == n_box) {
+              group[next] = g;
+              to_visit.push_back(next);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Any path to the outside through id can go around it instead.
+  if (group_on_shell.size() <= 1 && !graph.is_on_outer_shell(id)) {
+    return false;
+  }
+
+  // The fewest steps from a vertex to the outer shell.
+  const auto distance_to_shell = [&graph](vertex_id v) {
+    auto distance = graph_t::no_vertex;
+    for (std::size_t d = 0; d < graph.dims_array.size(); ++d) {
+      const auto coord = graph.get_coord(d, v);
+      distance = std::min({distance, coord,
+                           static_cast<vertex_id>(graph.dims_array[d] - 1 -
+                                                  coord)});
+    }
+    return distance;
+  };
+
+  // Otherwise, each group not already on the shell may only have reached it
+  // through id, so search from it for the shell with id induced. Vertices
+  // closest to the shell are searched from first, so a group that is not cut
+  // off usually finds it without searching much else.
+  using entry = std::pair<vertex_id, vertex_id>;
+  for (std::size_t g = 0; g < group_on_shell.size(); ++g) {
+    if (group_on_shell[g]) {
+      continue;
+    }
+
+    const auto seed = box[seeds[g]];
+    std::unordered_set<vertex_id> reached{id, seed};
+    std::priority_queue<entry, std::vector<entry>, std::greater<>> to_search;
+    to_search.emplace(distance_to_shell(seed), seed);
+    bool opens = false;
+    while (!to_search.empty() && !opens) {
+      const auto [distance, v] = to_search.top();
+      to_search.pop();
+      opens = (distance == 0);
+
+      for (const auto neighbor : graph.vertices[v].neighbors) {
+        if (!sub.has(neighbor) && reached.insert(neighbor).second) {
+          to_search.emplace(distance_to_shell(neighbor), neighbor);
+        }
+      }
+    }
+
+    if (!opens) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class graph_t>
+void write_subtree(std::ostream &stream, const graph_t &graph,
+                   const subtree<graph_t> &sub) {
+  const auto &dims = graph.dims_array;
+
+  for (const auto d : dims) {
+    stream << d << ' ';
+  }
+  stream << "\n\n";
+
+  const auto symbol = [&sub](vertex_id id) { return sub.has(id) ? 'X' : '_'; };
+
+  // If 2 or 3 dimensions, print in a readable format. Otherwise, just print all
+  // on one line.
+  vertex_id id = 0;
+  if (dims.size() == 3) {
+    for (vertex_id i = 0; i < dims[0]; ++i) {
+      for (vertex_id j = 0; j < dims[1]; ++j) {
+        for (vertex_id k = 0; k < dims[2]; ++k) {
+          stream << symbol(id++);
+        }
+        stream << '\n';
+      }
+      stream << '\n';
+    }
+  } else if (dims.size() == 2) {
+    for (vertex_id i = 0; i < dims[0]; ++i) {
+      for (vertex_id j = 0; j < dims[1]; ++j) {
+        stream << symbol(id++);
+      }
+      stream << '\n';
+    }
+    stream << '\n';
+  } else {
+    for (; id < graph.vertices.size(); ++id) {
+      stream << symbol(id);
+    }
+    stream << "\n\n";
+  }
+
+  stream << sub.n_induced() << '\n';
+}
+
+template <class graph_t>
+basic_candidate_sink<graph_t>::basic_candidate_sink(const graph_t &graph,
+                                                    std::string outfile)
+    : m_graph{graph}, m_outfile{std::move(outfile)}, m_start_time{
+                                                         std::clock()} {}
+
+template <class graph_t>
+bool basic_candidate_sink<graph_t>::check(const subtree<graph_t> &sub) {
+  std::scoped_lock lock{m_mutex};
+
+  if (sub.n_induced() <= m_largest_tree) {
+    return false;
+  }
+
+  const auto thread_seconds =
+      static_cast<double>(std::clock() - m_start_time) / CLOCKS_PER_SEC;
+
+  if (has_enclosed_space(m_graph, sub)) {
+    if (sub.n_induced() > m_largest_with_enclosed) {
+      m_largest_with_enclosed = sub.n_induced();
+
+      std::ofstream file{m_outfile + "_enclosed"};
+      write_subtree(file, m_graph, sub);
+
+      std::clog << sub.n_induced() << " vertices with enclosed space, found at "
+                << thread_seconds << " thread-seconds" << std::endl;
+    }
+    return false;
+  }
+
+  m_largest_tree = sub.n_induced();
+  m_largest_with_enclosed = std::max(m_largest_with_enclosed, sub.n_induced());
+
+  std::ofstream file{m_outfile};
+  write_subtree(file, m_graph, sub);
+
+  std::clog << sub.n_induced() << " vertices, found at " << thread_seconds
+            << " thread-seconds" << std::endl;
+
+  return true;
+}
+
+template bool has_enclosed_space(const hrp_graph &, const subtree<hrp_graph> &);
+template bool has_enclosed_space(const implicit_hrp_graph &,
+                                 const subtree<implicit_hrp_graph> &);
+
+template bool encloses_space_by_adding(const hrp_graph &,
+                                       const subtree<hrp_graph> &, vertex_id);
+template bool encloses_space_by_adding(const implicit_hrp_graph &,
+                                       const subtree<implicit_hrp_graph> &,
+                                       vertex_id);
+
+template void write_subtree(std::ostream &, const hrp_graph &,
+                            const subtree<hrp_graph> &);
+template void write_subtree(std::ostream &, const implicit_hrp_graph &,
+                            const subtree<implicit_hrp_graph> &);
+
+template class basic_candidate_sink<hrp_graph>;
+template class basic_candidate_sink<implicit_hrp_graph>;
@@ -0,0 +1,44 @@
+#include "candidate.hpp"
+#include "subtree_zdd.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+// Counts the induced subtrees of a graph of each size with a ZDD, then prints
+// one of the largest. Dimensions are given as for the other programs, and are
+// fastest with the largest last.
+int main(int argc, char *argv[]) {
+  const auto args = std::span{argv, static_cast<std::size_t>(argc)};
+  if (args.size() < 2) {
+    std::cerr << "usage: " << args[0] << " <dimensions...>\n";
+    return 1;
+  }
+
+  std::vector<std::size_t> dims;
+  for (const std::string arg : args.subspan(1)) {
+    dims.push_back(static_cast<std::size_t>(std::stoul(arg)));
+  }
+  const graph_type graph{dims};
+
+  const auto start = std::chrono::steady_clock::now();
+  const subtree_zdd zdd{graph};
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  std::cout << zdd.nodes().size() << " nodes (" << elapsed.count()
+            << " seconds)\n";
+
+  big_uint total;
+  const auto by_size = zdd.count_by_size();
+  for (std::size_t k = 0; k < by_size.size(); ++k) {
+    std::cout << k << ": " << by_size[k] << '\n';
+    total += by_size[k];
+  }
+  std::cout << "total: " << total << "\n\n";
+
+  write_subtree(std::cout, graph, zdd.max_subtree());
+}
@@ -0,0 +1,74 @@
+#include "max_plus.hpp"
+
+#include "parallel_for.hpp"
+
+#include <algorithm>
+
+namespace {
+
+constexpr std::uint32_t row_block = 32, inner_block = 256, col_block = 1024;
+
+} // namespace
+
+max_plus_matrix max_plus_matrix::identity(std::uint32_t n) {
+  max_plus_matrix result{n};
+  for (std::uint32_t i = 0; i < n; ++i) {
+    result(i, i) = 0;
+  }
+  return result;
+}
+
+max_plus_matrix max_plus_matrix::operator*(const max_plus_matrix &other) const {
+  max_plus_matrix result{m_n};
+
+  const auto n_row_blocks = (m_n + row_block - 1) / row_block;
+  parallel_for(n_row_blocks, [this, &other, &result](std::size_t block) {
+    const auto row_begin = static_cast<std::uint32_t>(block) * row_block;
+    const auto row_end = std::min(m_n, row_begin + row_block);
+    for (std::uint32_t kk = 0; kk < m_n; kk += inner_block) {
+      const auto k_end = std::min(m_n, kk + inner_block);
+      for (std::uint32_t jj = 0; jj < m_n; jj += col_block) {
+        const auto j_end = std::min(m_n, jj + col_block);
+        for (auto i = row_begin; i < row_end; ++i) {
+          value_type *out = result.row(i);
+          for (auto k = kk; k < k_end; ++k) {
+            // Transfer matrices are sparse, so most rows are skipped.
+            const value_type a = (*this)(i, k);
+            if (missing(a)) {
+              continue;
+            }
+
+            const value_type *in = other.row(k);
+            for (auto j = jj; j < j_end; ++j) {
+              out[j] = std::max(out[j], a + in[j]);
+            }
+          }
+        }
+      }
+    }
+
+    // Keep missing entries at none, so repeated products cannot overflow.
+    for (auto i = row_begin; i < row_end; ++i) {
+      for (std::uint32_t j = 0; j < m_n; ++j) {
+        if (missing(result(i, j))) {
+          result(i, j) = none;
+        }
+      }
+    }
+  });
+
+  return result;
+}
+
+max_plus_matrix max_plus_matrix::pow(std::uint64_t power) const {
+  max_plus_matrix result = identity(m_n), base = *this;
+  for (; power > 0; power >>= 1) {
+    if (power & 1) {
+      result = result * base;
+    }
+    if (power > 1) {
+      base = base * base;
+    }
+  }
+  return result;
+}
@@ -0,0 +1,101 @@
+#include "parse_dims.hpp"
+#include "slice_graph.hpp"
+#include "slice_search.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+// Finds the maximum induced forest of each prism given, in one process. Each
+// size is a comma separated list of dimensions, in the same order as for the
+// other programs, the last of which is the length of the prism. Prisms with
+// the same cross-section share a slice graph, and all of them share the
+// lower dimensional graphs those are built from.
+//
+// By default, each prism is printed along with its size. With --power, only
+// the size is found, with a power of the max-plus transfer matrix, which can
+// reach far longer prisms. With --period, the length is instead the most
+// lengths to try while looking for where the maximum becomes periodic.
+int main(int argc, char *argv[]) {
+  const auto args = std::span{argv, static_cast<std::size_t>(argc)};
+
+  const auto usage = [&] {
+    std::cerr << "usage: " << args[0] << " [--power | --period] <dims>...\n"
+              << "  where each <dims> is like 3,4,5 (a 3x4 cross-section, "
+                 "length 5)\n";
+    return 1;
+  };
+
+  bool power = false, period = false;
+  std::size_t first_size = 1;
+  if (args.size() > 1) {
+    power = std::string{args[1]} == "--power";
+    period = std::string{args[1]} == "--period";
+    if (power || period) {
+      first_size = 2;
+    }
+  }
+
+  if (args.size() <= first_size) {
+    return usage();
+  }
+
+  for (const std::string arg : args.subspan(first_size)) {
+    auto parsed = parse_dims(arg);
+    if (!parsed || parsed->size() < 2) {
+      std::cerr << "could not read a cross-section and length from '" << arg
+                << "'\n";
+      return usage();
+    }
+    auto &dims = *parsed;
+
+    // A length of 0 is an empty prism, but the cross-section of one must
+    // have cells for its slice graph to be built.
+    if (std::ranges::find(dims.begin(), dims.end() - 1, 0) != dims.end() - 1) {
+      std::cerr << "the cross-section of '" << arg << "' has no cells\n";
+      return usage();
+    }
+
+    const auto length = dims.back();
+    dims.pop_back();
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto &graph = slice_graph::get(dims, true);
+    const auto elapsed = [&start] {
+      const std::chrono::duration<double> result =
+          std::chrono::steady_clock::now() - start;
+      return result.count();
+    };
+
+    if (period) {
+      const auto found = find_prism_period(graph, length);
+      if (found) {
+        std::cout << arg << ": periodic from length " << found->start
+                  << " with period " << found->period << ", gaining "
+                  << found->gain << " vertices per period";
+      } else {
+        std::cout << arg << ": no period found up to length " << length;
+      }
+      std::cout << " (" << elapsed() << " seconds)\n";
+    } else if (power) {
+      const auto best = max_prism_by_power(graph, length);
+      if (best) {
+        std::cout << arg << ": " << *best;
+      } else {
+        std::cout << arg << ": too long, use --period";
+      }
+      std::cout << " (" << elapsed() << " seconds)\n";
+    } else {
+      const auto best = max_prism(graph, length);
+      std::cout << arg << ": " << best.n_induced << " ("
+                << graph.slices().size() << " slices, "
+                << graph.vertices().size() << " vertices, " << graph.n_edges()
+                << " edges, " << elapsed() << " seconds)\n"
+                << best.path;
+    }
+  }
+}
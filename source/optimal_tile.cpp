@@ -0,0 +1,72 @@
+#include "parse_dims.hpp"
+#include "slice_graph.hpp"
+#include "slice_search.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <string>
+
+// Finds the densest tile of each cross-section given, in one process. Each
+// cross-section is a comma separated list of dimensions, in the same order as
+// for the other programs. Pass --dp to use the path DP from every start
+// instead of the cycle ratio search, and --dp --bounded to stop it early at
+// the density the search finds.
+int main(int argc, char *argv[]) {
+  const auto args = std::span{argv, static_cast<std::size_t>(argc)};
+
+  const auto usage = [&] {
+    std::cerr << "usage: " << args[0] << " [--dp [--bounded]] <dims>...\n"
+              << "  where each <dims> is like 3,4 (a 3x4 cross-section)\n";
+    return 1;
+  };
+
+  bool dp = false, bounded = false;
+  std::size_t first_size = 1;
+  if (args.size() > first_size && std::string{args[first_size]} == "--dp") {
+    dp = true;
+    ++first_size;
+    if (args.size() > first_size &&
+        std::string{args[first_size]} == "--bounded") {
+      bounded = true;
+      ++first_size;
+    }
+  }
+
+  if (args.size() <= first_size) {
+    return usage();
+  }
+
+  for (const std::string arg : args.subspan(first_size)) {
+    const auto dims = parse_dims(arg);
+    if (!dims || dims->empty()) {
+      std::cerr << "could not read dimensions from '" << arg << "'\n";
+      return usage();
+    }
+
+    if (std::ranges::find(*dims, 0) != dims->end()) {
+      std::cerr << "'" << arg << "' has no cells\n";
+      return usage();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto &graph = slice_graph::get(*dims, true);
+    const auto tile = dp ? max_density_tile_by_paths(graph, bounded)
+                         : max_density_tile(graph);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    if (!tile) {
+      std::cout << arg << ": no tiles exist (" << elapsed.count()
+                << " seconds)\n";
+      continue;
+    }
+
+    std::cout << arg << ": " << tile->density << " ("
+              << tile->path.vertices().size() << " slices, "
+              << elapsed.count() << " seconds)\n"
+              << tile->path;
+  }
+}
@@ -0,0 +1,59 @@
+#include "parse_dims.hpp"
+#include "slice_graph.hpp"
+#include "slice_search.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <span>
+#include <string>
+
+// Finds the largest induced tree of prisms with each cross-section given, for
+// every length up to the one given, in one process. Each size is a comma
+// separated list of dimensions, in the same order as for the other programs,
+// the last of which is the longest length.
+int main(int argc, char *argv[]) {
+  const auto args = std::span{argv, static_cast<std::size_t>(argc)};
+
+  const auto usage = [&] {
+    std::cerr << "usage: " << args[0] << " <dims>...\n"
+              << "  where each <dims> is like 3,4,5 (a 3x4 cross-section, "
+                 "lengths up to 5)\n";
+    return 1;
+  };
+
+  if (args.size() < 2) {
+    return usage();
+  }
+
+  for (const std::string arg : args.subspan(1)) {
+    auto parsed = parse_dims(arg);
+    if (!parsed || parsed->size() < 2) {
+      std::cerr << "could not read a cross-section and length from '" << arg
+                << "'\n";
+      return usage();
+    }
+    auto &dims = *parsed;
+
+    if (std::ranges::find(dims.begin(), dims.end() - 1, 0) != dims.end() - 1) {
+      std::cerr << "the cross-section of '" << arg << "' has no cells\n";
+      return usage();
+    }
+
+    const auto max_length = dims.back();
+    dims.pop_back();
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto &graph = slice_graph::get(dims, false);
+    const auto best = max_prism_trees(graph, max_length);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << arg << ": (" << graph.vertices().size() << " vertices, "
+              << elapsed.count() << " seconds)\n";
+    for (std::size_t length = 1; length < best.size(); ++length) {
+      std::cout << "  length " << length << ": " << best[length] << '\n';
+    }
+  }
+}
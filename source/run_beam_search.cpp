@@ -0,0 +1,60 @@
+#include "beam_search.hpp"
+#include "candidate.hpp"
+#include "config.hpp"
+
+#include <range/v3/view/drop.hpp>
+
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <span>
+#include <string>
+
+// Lattices with more vertices than this (about 64x64x64) are searched on an
+// implicit graph, which is slower to query but does not hold every vertex's
+// neighbors. --implicit picks it for any size.
+constexpr std::size_t max_materialized_vertices = std::size_t{1} << 18;
+
+template <class graph_t>
+void run(const std::vector<std::size_t> &dims, const std::string &outfile,
+         const beam_search_options &options) {
+  const graph_t graph{dims};
+  basic_candidate_sink<graph_t> sink{graph, outfile};
+
+  const auto best = beam_search(graph, options, sink);
+
+  std::cout << "Beam search result = " << best.n_induced() << '\n';
+}
+
+int main(int argc, char *argv[]) {
+  auto args = std::span{argv, static_cast<std::size_t>(argc)};
+
+  const bool implicit = args.size() > 1 && std::string{args[1]} == "--implicit";
+  if (implicit) {
+    args = args.subspan(1);
+  }
+
+  if (args.size() < 5) {
+    std::cerr << "usage: " << argv[0]
+              << " [--implicit] <outfile> <width> <playouts> <dimensions...>\n";
+    return 1;
+  }
+
+  beam_search_options options{
+      .width = std::stoull(args[2]),
+      .n_playouts = std::stoull(args[3]),
+  };
+
+  std::vector<std::size_t> dims;
+  for (const auto arg_str : args | ranges::views::drop(4)) {
+    dims.push_back(static_cast<std::size_t>(std::stoi(arg_str)));
+  }
+
+  const auto n_vertices = std::accumulate(dims.begin(), dims.end(),
+                                          std::size_t{1}, std::multiplies{});
+  if (implicit || n_vertices > max_materialized_vertices) {
+    run<implicit_hrp_graph>(dims, args[1], options);
+  } else {
+    run<graph_type>(dims, args[1], options);
+  }
+}
@@ -0,0 +1,79 @@
+#include "parse_dims.hpp"
+#include "slice_graph.hpp"
+#include "upper_bound.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+// Finds an upper bound on the maximum induced tree of each size given, and the
+// slabs it comes from. Each size is a comma separated list of dimensions, in
+// the same order as for the other programs. Slab optima are found with the
+// same slice graphs as optimal_cube, which every size shares.
+int main(int argc, char *argv[]) {
+  const auto args = std::span{argv, static_cast<std::size_t>(argc)};
+
+  const auto usage = [&] {
+    std::cerr << "usage: " << args[0] << " [--max-cells <n>] <dims>...\n"
+              << "  where each <dims> is like 20,20,20, and slabs whose "
+                 "cross-sections have\n  at most <n> cells (default 12) are "
+                 "solved exactly\n";
+    return 1;
+  };
+
+  std::size_t max_slice_cells = 12;
+  std::size_t first_size = 1;
+  if (args.size() > 2 && std::string{args[1]} == "--max-cells") {
+    const auto cells = parse_size(args[2]);
+    if (!cells) {
+      std::cerr << "could not read a number of cells from '" << args[2]
+                << "'\n";
+      return usage();
+    }
+    max_slice_cells = *cells;
+    first_size = 3;
+  }
+
+  if (args.size() <= first_size) {
+    return usage();
+  }
+
+  for (const std::string arg : args.subspan(first_size)) {
+    auto parsed = parse_dims(arg);
+    if (!parsed || parsed->empty()) {
+      std::cerr << "could not read dimensions from '" << arg << "'\n";
+      return usage();
+    }
+    const auto &dims = *parsed;
+
+    if (std::ranges::find(dims, 0) != dims.end()) {
+      std::cerr << "'" << arg << "' has no cells\n";
+      return usage();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const upper_bound_table bounds{dims, max_slice_cells};
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout << arg << ": " << bounds(dims) << " (" << elapsed.count()
+              << " seconds)\n";
+
+    std::map<std::vector<std::size_t>, std::size_t> counts;
+    for (const auto &slab : bounds.slabs(dims)) {
+      ++counts[slab];
+    }
+    for (const auto &[slab, count] : counts) {
+      std::cout << "  " << count << " x ";
+      for (std::size_t d = 0; d < slab.size(); ++d) {
+        std::cout << (d == 0 ? "" : ",") << slab[d];
+      }
+      std::cout << ": " << bounds(slab) << '\n';
+    }
+  }
+}
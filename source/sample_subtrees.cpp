@@ -0,0 +1,82 @@
+#include "candidate.hpp"
+#include "subtree_sampler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+// Draws induced subtrees of a graph uniformly at random, of any size or of one
+// size, and prints how many of each size were drawn and the first one drawn.
+// Dimensions are given as for count_subtrees.
+int main(int argc, char *argv[]) {
+  auto args = std::span{argv, static_cast<std::size_t>(argc)}.subspan(1);
+
+  std::optional<vertex_id> size;
+  std::size_t n_samples = 1000000;
+  std::uint64_t seed = 0;
+  for (; args.size() > 1 && std::string{args[0]}.starts_with("--");
+       args = args.subspan(2)) {
+    const std::string flag = args[0];
+    if (flag == "--size") {
+      size = static_cast<vertex_id>(std::stoul(args[1]));
+    } else if (flag == "--samples") {
+      n_samples = std::stoull(args[1]);
+    } else if (flag == "--seed") {
+      seed = std::stoull(args[1]);
+    } else {
+      break;
+    }
+  }
+
+  if (args.empty() || std::string{args[0]}.starts_with("--")) {
+    std::cerr << "usage: " << argv[0]
+              << " [--size <k>] [--samples <n>] [--seed <s>] <dimensions...>\n";
+    return 1;
+  }
+
+  std::vector<std::size_t> dims;
+  for (const std::string arg : args) {
+    dims.push_back(static_cast<std::size_t>(std::stoul(arg)));
+  }
+  const graph_type graph{dims};
+
+  const subtree_zdd zdd{graph};
+  if (size && *size > zdd.max_size()) {
+    std::cerr << "no induced subtree has " << *size << " vertices, the most is "
+              << zdd.max_size() << '\n';
+    return 1;
+  }
+  const auto sampler = size ? subtree_sampler{zdd, *size} : subtree_sampler{zdd};
+
+  std::vector<std::atomic<std::size_t>> by_size(zdd.max_size() + std::size_t{1});
+  std::vector<vertex_id> first;
+  const auto start = std::chrono::steady_clock::now();
+  sampler.sample(n_samples, seed,
+                 [&](std::size_t i, std::span<const vertex_id> induced) {
+                   ++by_size[induced.size()];
+                   if (i == 0) {
+                     first.assign(induced.begin(), induced.end());
+                   }
+                 });
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  std::cout << n_samples << " samples (" << elapsed.count() << " seconds, "
+            << static_cast<double>(n_samples) / elapsed.count()
+            << " per second)\n";
+  for (std::size_t k = 0; k < by_size.size(); ++k) {
+    if (by_size[k] > 0) {
+      std::cout << k << ": " << by_size[k] << '\n';
+    }
+  }
+  std::cout << '\n';
+
+  if (!first.empty()) {
+    write_subtree(std::cout, graph, subtree_type{graph, first});
+  }
+}
@@ -0,0 +1,833 @@
+#include "slice_graph.hpp"
+
+#include "parallel_for.hpp"
+#include "permutation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+using comp_num = slice_graph::comp_num;
+
+// Vertices have their successors found this many at a time per thread, then
+// are added to the graph in order, so the graph is the same every run.
+constexpr std::size_t wave_size_per_thread = 4;
+
+// Union-find over the components of two slices, each of which has fewer than
+// empty_cell components.
+class component_union {
+public:
+  explicit component_union(std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      m_parent[i] = static_cast<std::uint16_t>(i);
+    }
+  }
+
+  // Returns false if a and b were already in the same group.
+  bool merge(std::size_t a, std::size_t b) {
+    const auto ra = find(a), rb = find(b);
+    if (ra == rb) {
+      return false;
+    }
+    m_parent[ra] = rb;
+    return true;
+  }
+
+  // The group of each of the first n elements, numbered by first appearance.
+  [[nodiscard]] std::vector<comp_num> groups(std::size_t n) {
+    std::array<comp_num, max_size> label;
+    label.fill(slice_graph::empty_cell);
+
+    std::vector<comp_num> result(n);
+    comp_num n_groups = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      auto &l = label[find(i)];
+      if (l == slice_graph::empty_cell) {
+        l = n_groups++;
+      }
+      result[i] = l;
+    }
+    return result;
+  }
+
+private:
+  constexpr static std::size_t max_size = 2 * slice_graph::empty_cell;
+
+  std::array<std::uint16_t, max_size> m_parent;
+
+  std::uint16_t find(std::size_t a) {
+    while (m_parent[a] != a) {
+      m_parent[a] = m_parent[m_parent[a]];
+      a = m_parent[a];
+    }
+    return static_cast<std::uint16_t>(a);
+  }
+};
+
+[[nodiscard]] comp_num n_groups(const std::vector<comp_num> &groups) {
+  return groups.empty()
+             ? comp_num{0}
+             : static_cast<comp_num>(
+                   *std::max_element(groups.begin(), groups.end()) + 1);
+}
+
+// Compares only which cells are induced, not how they are numbered.
+[[nodiscard]] std::strong_ordering
+compare_physical(const std::vector<comp_num> &a,
+                 const std::vector<comp_num> &b) {
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const bool empty_a = slice_graph::is_empty(a[i]);
+    const bool empty_b = slice_graph::is_empty(b[i]);
+    if (empty_a != empty_b) {
+      return empty_a <=> empty_b;
+    }
+  }
+  return std::strong_ordering::equal;
+}
+
+// Builds the slice made of a path through the slice graph of the
+// cross-section without its last dimension.
+[[nodiscard]] slice_graph::slice
+make_slice(const slice_graph &sub, const std::vector<std::uint32_t> &path) {
+  const std::size_t sub_cells = sub.n_cells();
+
+  std::size_t total_comps = 0;
+  std::uint32_t n_induced = 0;
+  for (const auto v : path) {
+    total_comps += sub.slice_of(v).n_comps;
+    n_induced += sub.slice_of(v).n_induced;
+  }
+
+  // Merge the components of each pair of adjacent sub-slices. The path is
+  // already known to be acyclic, so there is no need to check.
+  component_union comps{total_comps};
+  std::size_t base = 0;
+  for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+    const auto &s1 = sub.slice_of(path[i]);
+    const auto &s2 = sub.slice_of(path[i + 1]);
+    const auto &f1 = s1.forms[0];
+    const auto &f2 = s2.forms[0];
+
+    for (std::size_t j = 0; j < sub_cells; ++j) {
+      if (!slice_graph::is_empty(f1[j]) && !slice_graph::is_empty(f2[j])) {
+        comps.merge(base + f1[j], base + s1.n_comps + f2[j]);
+      }
+    }
+    base += s1.n_comps;
+  }
+
+  const auto groups = comps.groups(total_comps);
+
+  std::vector<comp_num> form;
+  form.reserve(path.size() * sub_cells);
+  base = 0;
+  for (const auto v : path) {
+    const auto &s = sub.slice_of(v);
+    for (const auto c : s.forms[0]) {
+      // Keep empty cells as they are, in case they are completely empty.
+      form.push_back(slice_graph::is_empty(c) ? c : groups[base + c]);
+    }
+    base += s.n_comps;
+  }
+
+  // Completely empty cells with an induced cell on either side in the last
+  // dimension are only empty. (By induction, they have none in the others.)
+  for (std::size_t i = 0; i < form.size(); ++i) {
+    if (form[i] == slice_graph::completely_empty_cell &&
+        ((i >= sub_cells && !slice_graph::is_empty(form[i - sub_cells])) ||
+         (i + sub_cells < form.size() &&
+          !slice_graph::is_empty(form[i + sub_cells])))) {
+      form[i] = slice_graph::empty_cell;
+    }
+  }
+
+  return {n_induced, n_groups(groups), {std::move(form)}};
+}
+
+// Returns true iff a slice can be pruned, otherwise adds each physically
+// different symmetry of it to its forms.
+[[nodiscard]] bool prune_or_fill(slice_graph::slice &s, std::size_t n_dims,
+                                 const permutation_set &perms) {
+  if (n_dims == 1) {
+    // Both pruning rules (see optimizations.txt) as a DFA, which accepts if
+    // the slice should be pruned. Its states are:
+    //   0: 'X' (fewer than 2 empty cells before)
+    //   1: '_', exactly one empty cell, after an X with at most one empty
+    //      cell before that (the start state)
+    //   2: '__' after the same (accepting if the slice ends here)
+    //   3: '__X'
+    //   4: '__X_' (accepting if the slice ends here)
+    //   5: either '___' or '__X__' has been seen (always accepting)
+    constexpr std::array<unsigned, 10> transition{0, 1, 0, 2, 3, 5, 0, 4, 0, 5};
+
+    unsigned state = 1;
+    for (const auto c : s.forms[0]) {
+      state = transition[2 * state + slice_graph::is_empty(c)];
+      if (state == 5) {
+        return true;
+      }
+    }
+    if (state == 2 || state == 4) {
+      return true;
+    }
+  } else if (std::ranges::find(s.forms[0], slice_graph::completely_empty_cell) !=
+             s.forms[0].end()) {
+    return true;
+  }
+
+  // Keep only the lexicographically smallest symmetry of each physical form.
+  std::vector<comp_num> result(s.forms[0].size());
+  for (const auto &perm : perms.perms()) {
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      result[i] = s.forms[0][perm[i]];
+    }
+
+    if (compare_physical(s.forms[0], result) > 0) {
+      return true;
+    }
+
+    if (std::ranges::none_of(s.forms, [&result](const auto &form) {
+          return compare_physical(form, result) == 0;
+        })) {
+      s.forms.push_back(result);
+    }
+  }
+
+  return false;
+}
+
+// Returns true iff after can follow before (a form of a slice with the given
+// groups) without creating a cycle, and if so sets groups_out to the groups
+// of after.
+[[nodiscard]] bool succeeds(const std::vector<comp_num> &after,
+                            comp_num after_n_comps,
+                            const std::vector<comp_num> &before,
+                            const std::vector<comp_num> &before_groups,
+                            std::vector<comp_num> &groups_out) {
+  // Elements are the components of after, then the groups of before.
+  component_union comps{std::size_t{after_n_comps} + n_groups(before_groups)};
+  for (std::size_t i = 0; i < after.size(); ++i) {
+    if (!slice_graph::is_empty(after[i]) && !slice_graph::is_empty(before[i]) &&
+        !comps.merge(after[i], after_n_comps + before_groups[before[i]])) {
+      return false;
+    }
+  }
+
+  groups_out = comps.groups(after_n_comps);
+  return true;
+}
+
+// The slices that can follow a vertex, and the groups they would have.
+struct successors {
+  std::vector<std::uint32_t> slice_ids;
+  std::vector<std::vector<comp_num>> groups;
+};
+
+// Removes the successors from index first on, which are all for the same
+// slice, whose groups are derived from (at least as connected as) another's.
+// Any later slice that can follow one of those can follow the other, with
+// groups that are no more connected (see optimizations.txt). As dominated
+// groups are never added, vertices only reachable through them are never
+// created either.
+void prune_derived(successors &out, std::size_t first) {
+  const auto derived_from = [](const std::vector<comp_num> &a,
+                               const std::vector<comp_num> &b) {
+    std::array<comp_num, slice_graph::empty_cell> match;
+    match.fill(slice_graph::empty_cell);
+    for (std::size_t j = 0; j < a.size(); ++j) {
+      if (match[b[j]] == slice_graph::empty_cell) {
+        match[b[j]] = a[j];
+      } else if (match[b[j]] != a[j]) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const std::size_t count = out.slice_ids.size() - first;
+  std::vector<bool> keep(count);
+  for (std::size_t k = 0; k < count; ++k) {
+    const auto &groups = out.groups[first + k];
+    bool derived = false;
+    for (std::size_t other = 0; other < count && !derived; ++other) {
+      if (other == k) {
+        continue;
+      }
+
+      // Equal groupings are derived from each other, keep the first.
+      const auto &other_groups = out.groups[first + other];
+      derived = derived_from(groups, other_groups) &&
+                (other < k || !derived_from(other_groups, groups));
+    }
+    keep[k] = !derived;
+  }
+
+  std::size_t kept = first;
+  for (std::size_t k = 0; k < count; ++k) {
+    if (keep[k]) {
+      if (kept != first + k) {
+        out.groups[kept] = std::move(out.groups[first + k]);
+      }
+      ++kept;
+    }
+  }
+  out.slice_ids.resize(kept);
+  out.groups.resize(kept);
+}
+
+// Calls f on every path of a given length through a slice graph that
+// extends the given one.
+template <class F>
+void for_each_path(const slice_graph &graph, std::vector<std::uint32_t> &path,
+                   std::size_t length, F &&f) {
+  if (path.size() == length) {
+    f(path);
+    return;
+  }
+
+  for (const auto adj : graph.vertices()[path.back()].adj) {
+    path.push_back(adj);
+    for_each_path(graph, path, length, f);
+    path.pop_back();
+  }
+}
+
+// A key for a vertex, its slice then its groups.
+[[nodiscard]] std::string vertex_key(std::uint32_t slice_id,
+                                     const std::vector<comp_num> &groups) {
+  std::string key(sizeof(slice_id) + groups.size(), '\0');
+  std::memcpy(key.data(), &slice_id, sizeof(slice_id));
+  std::ranges::copy(groups, key.begin() + sizeof(slice_id));
+  return key;
+}
+
+// A hash of a buffer whose size is a multiple of 8, one word at a time.
+[[nodiscard]] std::uint64_t checksum(std::span<const char> data) {
+  std::uint64_t h = 0xCBF29CE484222325ull;
+  for (std::size_t i = 0; i < data.size(); i += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, data.data() + i, sizeof(word));
+    h = (h ^ word) * 0x100000001B3ull;
+  }
+  return h;
+}
+
+/*
+A cache file is a header followed by a sequence of arrays, each padded to a
+multiple of 8 bytes:
+
+  dims         uint64[n_dims]
+  n_induced    uint32[n_slices]
+  n_comps      uint8 [n_slices]
+  form_offsets uint64[n_slices + 1]   first form of each slice
+  forms        uint8 [n_forms * n_cells]
+  vertex_slice uint32[n_vertices]
+  groups       uint8 [n_comps of the slice of each vertex, in order]
+  adj_offsets  uint64[n_vertices + 1] first edge of each vertex
+  adj          uint32[n_edges]
+*/
+struct cache_header {
+  char magic[4];
+  std::uint32_t version;
+  std::uint64_t prune, n_dims, n_slices, n_forms, n_vertices, n_edges;
+
+  // Of everything after the header, to catch damaged files.
+  std::uint64_t checksum;
+};
+
+constexpr std::array<char, 4> cache_magic{'S', 'L', 'G', 'R'};
+
+// This must be increased whenever the format, or the way slice graphs are
+// built, changes, so that old files are rebuilt instead of used.
+constexpr std::uint32_t cache_version = 1;
+
+[[nodiscard]] constexpr std::size_t align(std::size_t n) {
+  return (n + 7) & ~std::size_t{7};
+}
+
+// Reads the arrays of a cache file in order. Nothing is read past the end,
+// after which ok() is false.
+class cache_reader {
+public:
+  explicit cache_reader(std::vector<char> data) : m_data{std::move(data)} {}
+
+  template <class T> void take(T &out) {
+    if (m_ok && sizeof(T) <= m_data.size() - m_pos) {
+      std::memcpy(&out, m_data.data() + m_pos, sizeof(T));
+      m_pos = std::min(m_data.size(), align(m_pos + sizeof(T)));
+    } else {
+      m_ok = false;
+    }
+  }
+
+  template <class T> void take(std::vector<T> &out, std::uint64_t n) {
+    if (m_ok && n <= (m_data.size() - m_pos) / sizeof(T)) {
+      out.resize(n);
+      std::memcpy(out.data(), m_data.data() + m_pos, n * sizeof(T));
+      m_pos = std::min(m_data.size(), align(m_pos + n * sizeof(T)));
+    } else {
+      m_ok = false;
+    }
+  }
+
+  [[nodiscard]] bool ok() const { return m_ok; }
+
+  // The checksum of everything not yet read.
+  [[nodiscard]] std::uint64_t checksum_rest() const {
+    return checksum(std::span{m_data}.subspan(m_pos).first(
+        (m_data.size() - m_pos) & ~std::size_t{7}));
+  }
+
+private:
+  std::vector<char> m_data;
+  std::size_t m_pos = 0;
+  bool m_ok = true;
+};
+
+// Collects arrays in the same layout as cache_reader reads them.
+class cache_writer {
+public:
+  template <class T> void put(std::span<const T> items) {
+    const auto pos = m_buffer.size();
+    m_buffer.resize(align(pos + items.size_bytes()));
+    if (!items.empty()) {
+      std::memcpy(m_buffer.data() + pos, items.data(), items.size_bytes());
+    }
+  }
+
+  template <class T> void put(const std::vector<T> &items) {
+    put(std::span{items});
+  }
+
+  // Writes the header, with the checksum of everything put, then the arrays.
+  // They are written to a temporary file that is then renamed, so a file that
+  // exists is always complete even if other runs write it too.
+  [[nodiscard]] bool commit(cache_header header,
+                            const std::filesystem::path &path) const {
+    header.checksum = checksum(m_buffer);
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    auto temp = path;
+    temp += "." + std::to_string(std::random_device{}()) + ".tmp";
+    {
+      std::ofstream file{temp, std::ios::binary};
+      file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+      if (!file) {
+        file.close();
+        std::filesystem::remove(temp, ec);
+        return false;
+      }
+    }
+
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+      std::filesystem::remove(temp, ec);
+      return false;
+    }
+    return true;
+  }
+
+private:
+  std::vector<char> m_buffer;
+};
+
+static_assert(sizeof(cache_header) % 8 == 0);
+
+} // namespace
+
+const slice_graph &slice_graph::get(std::span<const std::size_t> dims,
+                                    bool prune) {
+  // Building a graph gets the graph of its sub-slices, so this
+  // is re-entered by the thread that holds the lock.
+  static std::recursive_mutex mutex;
+  static std::map<std::pair<bool, std::vector<std::size_t>>,
+                  std::unique_ptr<slice_graph>>
+      graphs;
+
+  const std::scoped_lock lock{mutex};
+
+  std::pair key{prune, std::vector<std::size_t>(dims.begin(), dims.end())};
+  auto it = graphs.find(key);
+  if (it == graphs.end()) {
+    std::unique_ptr<slice_graph> graph{new slice_graph(dims, prune)};
+    if (!graph->load()) {
+      graph->enumerate_slices();
+      graph->fill_vertices();
+      graph->save();
+    }
+    it = graphs.emplace(std::move(key), std::move(graph)).first;
+  }
+  return *it->second;
+}
+
+slice_graph::slice_graph(std::span<const std::size_t> dims, bool prune)
+    : m_dims(dims.begin(), dims.end()), m_prune{prune},
+      m_n_cells{std::accumulate(dims.begin(), dims.end(), std::size_t{1},
+                                std::multiplies{})} {}
+
+std::size_t slice_graph::n_edges() const {
+  std::size_t result = 0;
+  for (const auto &v : m_vertices) {
+    result += v.adj.size();
+  }
+  return result;
+}
+
+std::size_t slice_graph::edge_form(std::uint32_t before,
+                                   std::uint32_t after) const {
+  const auto &forms = slice_of(before).forms;
+  const auto &next = slice_of(after);
+
+  std::vector<comp_num> groups;
+  for (std::size_t f = 0; f < forms.size(); ++f) {
+    if (succeeds(next.forms[0], next.n_comps, forms[f],
+                 m_vertices[before].groups, groups) &&
+        groups == m_vertices[after].groups) {
+      return f;
+    }
+  }
+  return forms.size();
+}
+
+std::string slice_graph::cache_file() const {
+  std::string name = m_prune ? "pruned" : "unpruned";
+  for (const auto d : m_dims) {
+    name += '_' + std::to_string(d);
+  }
+  return (std::filesystem::path{cache_directory} / (name + ".bin")).string();
+}
+
+bool slice_graph::load() {
+  // The graph with no dimensions is trivial, so is not cached.
+  if (cache_directory.empty() || m_dims.empty()) {
+    return false;
+  }
+
+  std::ifstream file{cache_file(), std::ios::binary};
+  if (!file) {
+    return false;
+  }
+  cache_reader in{{std::istreambuf_iterator<char>{file}, {}}};
+
+  cache_header h;
+  in.take(h);
+  if (!in.ok() || !std::ranges::equal(h.magic, cache_magic) ||
+      h.version != cache_version || h.prune != m_prune ||
+      h.n_dims != m_dims.size() || h.checksum != in.checksum_rest()) {
+    return false;
+  }
+
+  std::vector<std::uint64_t> dims, form_offsets, adj_offsets;
+  std::vector<std::uint32_t> n_induced, vertex_slice, adj;
+  std::vector<comp_num> n_comps, forms, groups;
+  in.take(dims, h.n_dims);
+  in.take(n_induced, h.n_slices);
+  in.take(n_comps, h.n_slices);
+  in.take(form_offsets, h.n_slices + 1);
+  if (!in.ok() || h.n_forms > std::numeric_limits<std::size_t>::max() / m_n_cells) {
+    return false;
+  }
+  in.take(forms, h.n_forms * m_n_cells);
+  in.take(vertex_slice, h.n_vertices);
+  if (!in.ok() || !std::ranges::equal(dims, m_dims) ||
+      h.n_vertices < h.n_slices) {
+    return false;
+  }
+
+  // Anything inconsistent means the file is damaged, so start over as though
+  // it was not there.
+  const auto fail = [this] {
+    m_slices.clear();
+    m_vertices.clear();
+    return false;
+  };
+
+  m_slices.reserve(h.n_slices);
+  for (std::size_t s = 0; s < h.n_slices; ++s) {
+    const auto first = form_offsets[s], last = form_offsets[s + 1];
+    if (n_comps[s] >= completely_empty_cell || first >= last ||
+        last > h.n_forms || (!m_prune && last - first != 1)) {
+      return fail();
+    }
+
+    auto &current = m_slices.emplace_back(n_induced[s], n_comps[s]);
+    for (auto f = first; f < last; ++f) {
+      const auto form = std::span{forms}.subspan(f * m_n_cells, m_n_cells);
+      if (!std::ranges::all_of(form, [&current](comp_num c) {
+            return is_empty(c) || c < current.n_comps;
+          })) {
+        return fail();
+      }
+      current.forms.emplace_back(form.begin(), form.end());
+    }
+  }
+
+  std::size_t n_groups = 0;
+  for (std::size_t v = 0; v < h.n_vertices; ++v) {
+    // The first vertices are each slice with no components connected.
+    if (vertex_slice[v] >= h.n_slices ||
+        (v < h.n_slices && vertex_slice[v] != v)) {
+      return fail();
+    }
+    n_groups += m_slices[vertex_slice[v]].n_comps;
+  }
+
+  in.take(groups, n_groups);
+  in.take(adj_offsets, h.n_vertices + 1);
+  in.take(adj, h.n_edges);
+  if (!in.ok()) {
+    return fail();
+  }
+
+  m_vertices.reserve(h.n_vertices);
+  auto next_groups = groups.begin();
+  for (std::size_t v = 0; v < h.n_vertices; ++v) {
+    const auto first = adj_offsets[v], last = adj_offsets[v + 1];
+    const auto size = m_slices[vertex_slice[v]].n_comps;
+    if (first > last || last > h.n_edges ||
+        !std::all_of(adj.begin() + static_cast<std::ptrdiff_t>(first),
+                     adj.begin() + static_cast<std::ptrdiff_t>(last),
+                     [&h](std::uint32_t a) { return a < h.n_vertices; }) ||
+        !std::all_of(next_groups, next_groups + size,
+                     [size](comp_num g) { return g < size; })) {
+      return fail();
+    }
+
+    m_vertices.push_back(
+        {{adj.begin() + static_cast<std::ptrdiff_t>(first),
+          adj.begin() + static_cast<std::ptrdiff_t>(last)},
+         vertex_slice[v],
+         {next_groups, next_groups + size}});
+    next_groups += size;
+  }
+
+  return true;
+}
+
+bool slice_graph::save() const {
+  if (cache_directory.empty() || m_dims.empty()) {
+    return false;
+  }
+
+  std::vector<std::uint64_t> form_offsets{0}, adj_offsets{0};
+  std::vector<std::uint32_t> n_induced, vertex_slice, adj;
+  std::vector<comp_num> n_comps, forms, groups;
+  for (const auto &s : m_slices) {
+    n_induced.push_back(s.n_induced);
+    n_comps.push_back(s.n_comps);
+    for (const auto &form : s.forms) {
+      forms.insert(forms.end(), form.begin(), form.end());
+    }
+    form_offsets.push_back(forms.size() / m_n_cells);
+  }
+  for (const auto &v : m_vertices) {
+    vertex_slice.push_back(v.slice_id);
+    groups.insert(groups.end(), v.groups.begin(), v.groups.end());
+    adj.insert(adj.end(), v.adj.begin(), v.adj.end());
+    adj_offsets.push_back(adj.size());
+  }
+
+  cache_header h{};
+  std::ranges::copy(cache_magic, h.magic);
+  h.version = cache_version;
+  h.prune = m_prune;
+  h.n_dims = m_dims.size();
+  h.n_slices = m_slices.size();
+  h.n_forms = forms.size() / m_n_cells;
+  h.n_vertices = m_vertices.size();
+  h.n_edges = adj.size();
+
+  const std::vector<std::uint64_t> dims(m_dims.begin(), m_dims.end());
+
+  cache_writer out;
+  out.put(dims);
+  out.put(n_induced);
+  out.put(n_comps);
+  out.put(form_offsets);
+  out.put(forms);
+  out.put(vertex_slice);
+  out.put(groups);
+  out.put(adj_offsets);
+  out.put(adj);
+  return out.commit(h, cache_file());
+}
+
+void slice_graph::enumerate_slices() {
+  if (m_dims.empty()) {
+    // A single cell, which is either empty or induced.
+    m_slices.push_back({0, 0, {{completely_empty_cell}}});
+    m_slices.push_back({1, 1, {{0}}});
+    return;
+  }
+
+  // Sub-graphs are never pruned.
+  const auto &sub =
+      get(std::span{m_dims}.first(m_dims.size() - 1), false);
+  const std::optional<permutation_set> perms =
+      m_prune ? std::optional{permutation_set{m_dims}} : std::nullopt;
+
+  // Slices are found in parallel by the first sub-slice of their paths,
+  // which must have no history, then put back in order.
+  const auto n_starts = sub.slices().size();
+  std::vector<std::vector<slice>> found(n_starts);
+  parallel_for(n_starts, [&](std::size_t start) {
+    std::vector<std::uint32_t> path{static_cast<std::uint32_t>(start)};
+    for_each_path(sub, path, m_dims.back(), [&](const auto &p) {
+      auto s = make_slice(sub, p);
+      if (!perms || !prune_or_fill(s, m_dims.size(), *perms)) {
+        found[start].push_back(std::move(s));
+      }
+    });
+  });
+
+  for (auto &f : found) {
+    std::ranges::move(f, std::back_inserter(m_slices));
+  }
+}
+
+void slice_graph::fill_vertices() {
+  std::unordered_map<std::string, std::uint32_t> index;
+
+  const auto get_vertex = [this, &index](std::uint32_t slice_id,
+                                         std::vector<comp_num> &&groups) {
+    const auto [it, inserted] = index.try_emplace(
+        vertex_key(slice_id, groups),
+        static_cast<std::uint32_t>(m_vertices.size()));
+    if (inserted) {
+      m_vertices.push_back({{}, slice_id, std::move(groups)});
+    }
+    return it->second;
+  };
+
+  // Each slice with none of its components connected.
+  for (std::uint32_t i = 0; i < m_slices.size(); ++i) {
+    std::vector<comp_num> groups(m_slices[i].n_comps);
+    std::iota(groups.begin(), groups.end(), comp_num{0});
+    get_vertex(i, std::move(groups));
+  }
+
+  const auto find_successors = [this](std::size_t v, successors &out) {
+    const auto &before = slice_of(static_cast<std::uint32_t>(v));
+    const auto &before_groups = m_vertices[v].groups;
+
+    std::vector<comp_num> groups;
+    for (std::uint32_t i = 0; i < m_slices.size(); ++i) {
+      const auto first = out.slice_ids.size();
+
+      // Using the canonical form of after and every symmetry of before gives
+      // every way after can follow before, up to symmetry.
+      for (const auto &form : before.forms) {
+        if (succeeds(m_slices[i].forms[0], m_slices[i].n_comps, form,
+                     before_groups, groups)) {
+          out.slice_ids.push_back(i);
+          out.groups.push_back(std::move(groups));
+        }
+      }
+
+      if (m_prune && out.slice_ids.size() - first > 1) {
+        prune_derived(out, first);
+      }
+    }
+  };
+
+  // Successors are found in parallel, but new vertices are added between
+  // waves, in order. Filling a vertex can add new ones, which are filled
+  // in a later wave.
+  const std::size_t max_wave_size =
+      wave_size_per_thread * std::max(1u, std::thread::hardware_concurrency());
+  std::vector<successors> found(max_wave_size);
+  std::vector<bool> adjacent;
+  for (std::size_t start = 0, wave_size; start < m_vertices.size();
+       start += wave_size) {
+    wave_size = std::min(max_wave_size, m_vertices.size() - start);
+
+    parallel_for(wave_size, [&](std::size_t k) {
+      found[k] = {};
+      find_successors(start + k, found[k]);
+    });
+
+    for (std::size_t k = 0; k < wave_size; ++k) {
+      std::vector<std::uint32_t> adj;
+      for (std::size_t s = 0; s < found[k].slice_ids.size(); ++s) {
+        const auto next =
+            get_vertex(found[k].slice_ids[s], std::move(found[k].groups[s]));
+
+        // Different symmetries of before can give the same successor.
+        adjacent.resize(m_vertices.size());
+        if (!adjacent[next]) {
+          adjacent[next] = true;
+          adj.push_back(next);
+        }
+      }
+
+      for (const auto a : adj) {
+        adjacent[a] = false;
+      }
+      m_vertices[start + k].adj = std::move(adj);
+    }
+  }
+}
+
+std::size_t max_prism_forest(const slice_graph &graph, std::size_t length) {
+  return max_prism_forests(graph, length).back();
+}
+
+std::vector<std::size_t> max_prism_forests(const slice_graph &graph,
+                                           std::size_t max_length) {
+  std::vector<std::size_t> best{0};
+  if (max_length == 0) {
+    return best;
+  }
+
+  // The most induced vertices of a prism of the current length
+  // ending in each vertex, or -1 if there are none.
+  const auto &vertices = graph.vertices();
+  std::vector<std::int64_t> layer(vertices.size(), -1), next;
+  for (std::uint32_t v = 0; v < graph.slices().size(); ++v) {
+    layer[v] = graph.slice_of(v).n_induced;
+  }
+
+  for (std::size_t len = 1;; ++len) {
+    best.push_back(static_cast<std::size_t>(
+        std::max<std::int64_t>(0, *std::ranges::max_element(layer))));
+    if (len == max_length) {
+      return best;
+    }
+
+    next.assign(vertices.size(), -1);
+    for (std::size_t v = 0; v < vertices.size(); ++v) {
+      if (layer[v] < 0) {
+        continue;
+      }
+      for (const auto adj : vertices[v].adj) {
+        next[adj] = std::max<std::int64_t>(next[adj],
+                                           layer[v] + graph.slice_of(adj).n_induced);
+      }
+    }
+    std::swap(layer, next);
+  }
+}
@@ -0,0 +1,121 @@
+#include "slice_path.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+using cell_map = slice_path::cell_map;
+
+[[nodiscard]] cell_map identity(std::size_t n_cells) {
+  cell_map m(n_cells);
+  std::iota(m.begin(), m.end(), std::uint32_t{0});
+  return m;
+}
+
+// The cell map of applying perm to a slice shown with the given map.
+[[nodiscard]] cell_map compose(std::span<const std::uint32_t> perm,
+                               const cell_map &shown) {
+  cell_map m(shown.size());
+  for (std::size_t k = 0; k < m.size(); ++k) {
+    m[k] = perm[shown[k]];
+  }
+  return m;
+}
+
+} // namespace
+
+slice_path::slice_path(const slice_graph &graph,
+                       std::vector<std::uint32_t> vertices)
+    : m_graph{&graph}, m_vertices{std::move(vertices)} {}
+
+slice_path::slice_path(const slice_graph &graph,
+                       const predecessor_matrix &preds, std::size_t len,
+                       std::uint32_t end)
+    : m_graph{&graph}, m_vertices(len) {
+  auto current = end;
+  for (auto length = len; length > 0; --length) {
+    m_vertices[length - 1] = current;
+    current = preds.get(length, current);
+  }
+}
+
+slice_path &slice_path::renumber(std::span<const std::uint32_t> original) {
+  for (auto &v : m_vertices) {
+    v = original[v];
+  }
+  return *this;
+}
+
+slice_path &slice_path::close_tile() {
+  if (m_vertices.empty()) {
+    return *this;
+  }
+
+  const permutation_set perms{m_graph->dims()};
+  const auto none = identity(m_graph->n_cells());
+
+  // The symmetry of the last slice one period earlier
+  auto period = none;
+  for (auto i = m_vertices.size() - 1; i-- > 0;) {
+    period = precede(perms, m_vertices[i], m_vertices[i + 1], period);
+  }
+  period = precede(perms, m_vertices.back(), m_vertices.front(), period);
+
+  const auto cycle = m_vertices;
+  for (auto m = period; m != none; m = compose(period, m)) {
+    m_vertices.insert(m_vertices.end(), cycle.begin(), cycle.end());
+  }
+  return *this;
+}
+
+std::vector<cell_map> slice_path::orientations() const {
+  std::vector<cell_map> result(m_vertices.size(),
+                               identity(m_graph->n_cells()));
+  if (m_vertices.size() < 2) {
+    return result;
+  }
+
+  const permutation_set perms{m_graph->dims()};
+  for (auto i = m_vertices.size() - 1; i-- > 0;) {
+    result[i] = precede(perms, m_vertices[i], m_vertices[i + 1], result[i + 1]);
+  }
+  return result;
+}
+
+cell_map slice_path::precede(const permutation_set &perms,
+                             std::uint32_t before, std::uint32_t after,
+                             const cell_map &shown) const {
+  const auto &forms = m_graph->slice_of(before).forms;
+  const auto f = m_graph->edge_form(before, after);
+
+  // Not an edge of the graph, so there is no symmetry to keep.
+  if (f == forms.size()) {
+    return shown;
+  }
+
+  // Each form after the first is the first permutation of it that gives that
+  // form, as the graph finds them.
+  for (const auto &perm : perms.perms()) {
+    if (std::ranges::equal(forms[f], perm, {}, {},
+                           [&forms](std::uint32_t cell) {
+                             return forms[0][cell];
+                           })) {
+      return compose(perm, shown);
+    }
+  }
+  return shown;
+}
+
+std::ostream &operator<<(std::ostream &stream, const slice_path &path) {
+  const auto orientations = path.orientations();
+  for (std::size_t i = 0; i < path.m_vertices.size(); ++i) {
+    const auto &form = path.m_graph->slice_of(path.m_vertices[i]).forms[0];
+    for (const auto cell : orientations[i]) {
+      stream << (slice_graph::is_empty(form[cell]) ? '_' : 'X');
+    }
+    stream << '\n';
+  }
+  return stream;
+}
@@ -0,0 +1,532 @@
+#include "slice_search.hpp"
+
+#include "cycle_ratio.hpp"
+#include "max_plus.hpp"
+#include "parallel_for.hpp"
+#include "predecessor_matrix.hpp"
+#include "reduced_graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <compare>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// What length to start checking for duplicate slices in the tiling DP.
+constexpr std::size_t check_start = 10;
+
+// How many vertices of a prism DP layer each thread fills at a time. This
+// must be a multiple of 64, so that threads set predecessors in separate
+// words.
+constexpr std::uint32_t dp_block_size = 1024;
+
+[[nodiscard]] auto successors_of(const slice_graph &graph) {
+  return [&graph](std::uint32_t u) -> const std::vector<std::uint32_t> & {
+    return graph.vertices()[u].adj;
+  };
+}
+
+[[nodiscard]] auto n_induced_of(const slice_graph &graph) {
+  return [&graph](std::uint32_t u) { return graph.slice_of(u).n_induced; };
+}
+
+[[nodiscard]] std::uint32_t n_vertices(const slice_graph &graph) {
+  return static_cast<std::uint32_t>(graph.vertices().size());
+}
+
+// Checks for duplicate vertices in each path of a given length, and resets
+// those that have duplicates. Returns true iff there are still paths to
+// explore.
+bool check_for_duplicate_tiles(std::vector<std::uint32_t> &n_induced,
+                               const predecessor_matrix &preds,
+                               std::size_t len) {
+  // The last path each vertex was on, so that nothing needs to be cleared
+  // between paths, and each is checked in time linear in its length.
+  const auto n = static_cast<std::uint32_t>(n_induced.size());
+  std::vector<std::uint32_t> used_by(n, n);
+
+  std::size_t n_paths = 0;
+  for (std::uint32_t i = 0; i < n; ++i) {
+    // Ignore paths that already do not exist
+    if (n_induced[i] == 0) {
+      continue;
+    }
+
+    ++n_paths;
+
+    auto current = i;
+    used_by[current] = i;
+    for (auto length = len; length > 0; --length) {
+      current = preds.get(length, current);
+
+      if (used_by[current] == i) {
+        n_induced[i] = 0;
+        --n_paths;
+        break;
+      }
+
+      used_by[current] = i;
+    }
+  }
+
+  return n_paths > 0;
+}
+
+// The best tile found by any start so far, shared between the threads running
+// each start.
+struct shared_tile {
+  std::mutex mutex;
+  std::optional<slice_path> tile;
+  fraction density;
+
+  // The start that found tile. Of tiles as dense and as long, the one from
+  // the lowest start is kept, so the result does not depend on which thread
+  // finds one first.
+  std::uint32_t start = std::numeric_limits<std::uint32_t>::max();
+
+  // No tile is denser than this. Fractions of equal value compare greater the
+  // shorter the tile, so density >= bound means the tile is also no longer.
+  // If set, once such a tile is found, every start after the one that found
+  // it can stop, as none of them can replace it.
+  std::optional<fraction> bound;
+
+  bool done(std::uint32_t from) {
+    const std::scoped_lock lock{mutex};
+    return bound && density >= *bound && start <= from;
+  }
+};
+
+void find_tiles_from(const slice_graph &graph, const reduced_graph &g,
+                     std::uint32_t start, shared_tile &best) {
+  // The most induced vertices of a path of the current and last lengths, and
+  // the predecessor of each vertex at each length so far. Lengths go up to
+  // one more than the size of the graph, so that all tiles with all slices
+  // would technically be accounted for, but most starts run out of paths long
+  // before that, so layers are only added as they are reached.
+  std::vector<std::uint32_t> current(g.size()), last(g.size());
+  predecessor_matrix preds{g.size()};
+  preds.add_layer();
+  preds.add_layer();
+
+  // Only a single vertex starts, since here there is a specific start.
+  current[start] = g.weight[start];
+
+  for (std::size_t len = 2; len < std::size_t{g.size()} + 2; ++len) {
+    // This is expensive to check, so it is only checked at each multiple
+    // of check_start.
+    if (len % check_start == 0 &&
+        !check_for_duplicate_tiles(current, preds, len - 1)) {
+      return;
+    }
+
+    // Another start may have found a tile that cannot be beaten.
+    if (best.done(start)) {
+      return;
+    }
+
+    std::swap(current, last);
+    std::ranges::fill(current, 0u);
+    preds.add_layer();
+
+    // Expand every path in every possible way
+    for (std::uint32_t end = 0; end < g.size(); ++end) {
+      const auto old_n_induced = last[end];
+
+      // Skip over paths that haven't started yet.
+      if (old_n_induced == 0) {
+        continue;
+      }
+
+      for (const auto adj : g.successors(end)) {
+        const auto new_n_induced = old_n_induced + g.weight[adj];
+        if (current[adj] < new_n_induced) {
+          current[adj] = new_n_induced;
+          preds.set(len, adj, end);
+        }
+      }
+    }
+
+    // If a cycle has been found, check to see if it is the new best
+    if (current[start] != 0) {
+      const auto end = preds.get(len, start);
+      const fraction density{last[end], (len - 1) * graph.n_cells()};
+
+      const std::scoped_lock lock{best.mutex};
+      const auto order = density <=> best.density;
+      if (std::is_gt(order) || (std::is_eq(order) && start < best.start)) {
+        best.tile = slice_path{graph, preds, len - 1, end}
+                        .renumber(g.original)
+                        .close_tile();
+        best.density = density;
+        best.start = start;
+      }
+    }
+  }
+}
+
+} // namespace
+
+std::optional<slice_tile> max_density_tile(const slice_graph &graph) {
+  // Tiles are cycles, so only the strongly connected components matter.
+  const auto g = reduce_for_cycles(n_vertices(graph), successors_of(graph),
+                                   n_induced_of(graph));
+
+  const auto best = max_cycle_ratio(
+      g.size(), [&g](std::uint32_t u) { return g.successors(u); },
+      [&g](std::uint32_t u) { return g.weight[u]; });
+  if (best.length == 0) {
+    return std::nullopt;
+  }
+
+  return slice_tile{{best.weight, best.length * graph.n_cells()},
+                    std::move(slice_path{graph, best.cycle}
+                                  .renumber(g.original)
+                                  .close_tile())};
+}
+
+std::optional<slice_tile> max_density_tile_by_paths(const slice_graph &graph,
+                                                    bool bounded) {
+  const auto g = reduce_for_cycles(n_vertices(graph), successors_of(graph),
+                                   n_induced_of(graph));
+
+  shared_tile best;
+  if (bounded) {
+    const auto bound = max_cycle_ratio(
+        g.size(), [&g](std::uint32_t u) { return g.successors(u); },
+        [&g](std::uint32_t u) { return g.weight[u]; });
+    best.bound = bound.length == 0
+                     ? fraction{0, 1}
+                     : fraction{bound.weight, bound.length * graph.n_cells()};
+  }
+
+  // Start from each vertex with no components connected, these come first in
+  // the slice graph, and so also in g. Each is a whole orbit of slices under
+  // the symmetries of the cross-section, so this already starts from one of
+  // each.
+  std::vector<std::uint32_t> starts;
+  for (std::uint32_t start = 0; start < g.size(); ++start) {
+    if (g.original[start] < graph.slices().size()) {
+      starts.push_back(start);
+    }
+  }
+
+  parallel_for(starts.size(), [&](std::size_t i) {
+    find_tiles_from(graph, g, starts[i], best);
+  });
+
+  if (!best.tile) {
+    return std::nullopt;
+  }
+  return slice_tile{best.density, std::move(*best.tile)};
+}
+
+slice_prism max_prism(const slice_graph &graph, std::size_t length) {
+  if (length == 0) {
+    return {0, slice_path{graph, {}}};
+  }
+
+  auto g = reduce_for_paths(n_vertices(graph), successors_of(graph),
+                            n_induced_of(graph), length);
+  if (g.size() == 0) {
+    return {0, slice_path{graph, {}}};
+  }
+  g.build_predecessors();
+
+  // The predecessor of each vertex at each length up to the given one, and
+  // the most induced vertices of a path of the current and last lengths.
+  predecessor_matrix preds{g.size()};
+  for (std::size_t len = 0; len <= length; ++len) {
+    preds.add_layer();
+  }
+  std::vector<std::uint32_t> current(g.weight), last(g.size());
+
+  for (std::size_t len = 2; len <= length; ++len) {
+    std::swap(current, last);
+
+    // Each vertex takes the best path into it from the last layer. Threads
+    // write to separate blocks of vertices, and only read the last layer.
+    // Predecessors are in increasing order, so ties go to the same one as
+    // expanding each vertex in order would.
+    parallel_for((g.size() + dp_block_size - 1) / dp_block_size,
+                 [&g, &last, &current, &preds, len](std::size_t block) {
+                   const auto block_begin =
+                       static_cast<std::uint32_t>(block) * dp_block_size;
+                   const auto block_end =
+                       std::min(g.size(), block_begin + dp_block_size);
+                   for (auto end = block_begin; end < block_end; ++end) {
+                     std::uint32_t best = 0, best_prev = 0;
+                     for (const auto prev : g.predecessors(end)) {
+                       const auto n_induced = last[prev] + g.weight[end];
+                       if (best < n_induced) {
+                         best = n_induced;
+                         best_prev = prev;
+                       }
+                     }
+
+                     current[end] = best;
+                     preds.set(len, end, best_prev);
+                   }
+                 });
+  }
+
+  const auto best_end = static_cast<std::uint32_t>(
+      std::ranges::max_element(current) - current.begin());
+  return {current[best_end],
+          std::move(slice_path{graph, preds, length, best_end}.renumber(
+              g.original))};
+}
+
+std::optional<std::size_t> max_prism_by_power(const slice_graph &graph,
+                                              std::uint64_t length) {
+  if (length > std::uint64_t{max_plus_matrix::max} / graph.n_cells()) {
+    return std::nullopt;
+  }
+  if (length == 0) {
+    return 0;
+  }
+
+  const auto g = reduce_for_paths(n_vertices(graph), successors_of(graph),
+                                  n_induced_of(graph), length);
+  const auto n = g.size();
+
+  // Entry (i,j) is the number of vertices added by going from i to j.
+  max_plus_matrix transfer{n};
+  for (std::uint32_t i = 0; i < n; ++i) {
+    for (const auto adj : g.successors(i)) {
+      transfer(i, adj) = static_cast<max_plus_matrix::value_type>(g.weight[adj]);
+    }
+  }
+
+  const auto walks = transfer.pow(length - 1);
+
+  max_plus_matrix::value_type best = 0;
+  for (std::uint32_t i = 0; i < n; ++i) {
+    for (std::uint32_t j = 0; j < n; ++j) {
+      if (!max_plus_matrix::missing(walks(i, j))) {
+        best = std::max(best, static_cast<max_plus_matrix::value_type>(
+                                  g.weight[i] + walks(i, j)));
+      }
+    }
+  }
+  return static_cast<std::size_t>(best);
+}
+
+std::optional<prism_period> find_prism_period(const slice_graph &graph,
+                                              std::size_t max_length) {
+  using value_type = std::int64_t;
+  constexpr value_type none = -1;
+
+  const auto &vertices = graph.vertices();
+  const auto n = vertices.size();
+
+  // The most vertices of a prism of the current length ending in each vertex,
+  // or none if there are none.
+  std::vector<value_type> layer(n, none), next(n);
+  for (std::uint32_t v = 0; v < graph.slices().size(); ++v) {
+    layer[v] = graph.slice_of(v).n_induced;
+  }
+
+  const auto advance = [&] {
+    std::ranges::fill(next, none);
+    for (std::size_t v = 0; v < n; ++v) {
+      if (layer[v] == none) {
+        continue;
+      }
+      for (const auto adj : vertices[v].adj) {
+        next[adj] = std::max<value_type>(next[adj],
+                                         layer[v] + graph.slice_of(adj).n_induced);
+      }
+    }
+    std::swap(layer, next);
+  };
+
+  // A layer less its maximum, as a string so it can be hashed.
+  const auto normalized = [&layer] {
+    const auto top = *std::ranges::max_element(layer);
+
+    std::string result;
+    for (const auto v : layer) {
+      const value_type d = v == none ? none : top - v;
+      result.append(reinterpret_cast<const char *>(&d), sizeof(d));
+    }
+    return std::pair{std::move(result), top};
+  };
+
+  // The first length each normalized layer was seen at, and the maximum for
+  // each length so far, from length 1.
+  std::unordered_map<std::string, std::size_t> seen;
+  std::vector<value_type> tops{0};
+
+  for (std::size_t len = 1; len <= max_length; ++len, advance()) {
+    auto [key, top] = normalized();
+    tops.push_back(top);
+
+    const auto [it, inserted] = seen.try_emplace(std::move(key), len);
+    if (inserted) {
+      continue;
+    }
+
+    // Every layer from the first repeat on repeats, so the maximum does too,
+    // but it may have a shorter period, and start repeating earlier.
+    const auto first = it->second, period = len - first;
+    const auto gain = top - tops[first];
+
+    // The maximum for any length, past the ones found by repeating them.
+    const auto max_for = [&](std::size_t length) {
+      const auto n_repeats = length < len ? 0 : (length - first) / period;
+      return tops[length - n_repeats * period] +
+             static_cast<value_type>(n_repeats) * gain;
+    };
+
+    // The shortest period is a divisor of any other, and it is enough to
+    // check one whole period from where the layers repeat.
+    for (std::size_t p = 1; p <= period; ++p) {
+      if (period % p != 0 || (gain * static_cast<value_type>(p)) %
+                                     static_cast<value_type>(period) !=
+                                 0) {
+        continue;
+      }
+
+      const auto p_gain =
+          gain * static_cast<value_type>(p) / static_cast<value_type>(period);
+      const auto repeats_from = [&](std::size_t length) {
+        return max_for(length + p) == max_for(length) + p_gain;
+      };
+
+      bool repeats = true;
+      for (auto length = first; length < len && repeats; ++length) {
+        repeats = repeats_from(length);
+      }
+      if (!repeats) {
+        continue;
+      }
+
+      auto start = first;
+      while (start > 1 && repeats_from(start - 1)) {
+        --start;
+      }
+      return prism_period{start, p, static_cast<std::size_t>(p_gain)};
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::vector<std::size_t> max_prism_trees(const slice_graph &graph,
+                                         std::size_t max_length) {
+  assert(!graph.pruned());
+
+  // The states a prism ending in each vertex can be in:
+  //   not_started: every slice so far is empty (so this one is too)
+  //   open:        every group of the vertex will be part of the tree
+  //   finished:    the tree ended in an earlier slice, this one is empty
+  enum : std::size_t { not_started, open, finished, n_states };
+
+  const auto &vertices = graph.vertices();
+  const auto n = vertices.size();
+
+  std::vector<std::size_t> best{0};
+  if (max_length == 0) {
+    return best;
+  }
+
+  // The number of groups of each vertex.
+  std::vector<std::size_t> n_groups(n);
+  for (std::size_t v = 0; v < n; ++v) {
+    const auto &groups = vertices[v].groups;
+    n_groups[v] = groups.empty() ? 0 : std::size_t{*std::ranges::max_element(groups)} + 1;
+  }
+
+  // Whether every group of each vertex touches the slice of each of its
+  // successors, in the order of the adjacency lists.
+  std::vector<std::size_t> edge_offsets(n + 1);
+  for (std::size_t v = 0; v < n; ++v) {
+    edge_offsets[v + 1] = edge_offsets[v] + vertices[v].adj.size();
+  }
+
+  std::vector<std::uint8_t> stays_open(edge_offsets[n]);
+  parallel_for(n, [&](std::size_t v) {
+    const auto &before = graph.slice_of(static_cast<std::uint32_t>(v)).forms[0];
+    const auto &groups = vertices[v].groups;
+
+    std::vector<bool> touched;
+    for (std::size_t k = 0; k < vertices[v].adj.size(); ++k) {
+      const auto &after = graph.slice_of(vertices[v].adj[k]).forms[0];
+
+      touched.assign(n_groups[v], false);
+      std::size_t n_touched = 0;
+      for (std::size_t i = 0; i < before.size(); ++i) {
+        if (!slice_graph::is_empty(before[i]) &&
+            !slice_graph::is_empty(after[i]) && !touched[groups[before[i]]]) {
+          touched[groups[before[i]]] = true;
+          ++n_touched;
+        }
+      }
+
+      stays_open[edge_offsets[v] + k] = n_touched == n_groups[v];
+    }
+  });
+
+  // The most vertices of a prism of the current length ending in each vertex
+  // and state, or none if there are none.
+  constexpr std::int64_t none = -1;
+  using states = std::array<std::int64_t, n_states>;
+  std::vector<states> layer(n, {none, none, none}), next(n);
+
+  // The first slice has no history, so has no components connected.
+  for (std::uint32_t v = 0; v < graph.slices().size(); ++v) {
+    const auto n_induced = graph.slice_of(v).n_induced;
+    layer[v][n_induced == 0 ? not_started : open] = n_induced;
+  }
+
+  for (std::size_t len = 1;; ++len) {
+    // The tree is done if it has finished, or is open with one group.
+    std::int64_t len_best = 0;
+    for (std::size_t v = 0; v < n; ++v) {
+      len_best = std::max(len_best, layer[v][finished]);
+      if (n_groups[v] == 1) {
+        len_best = std::max(len_best, layer[v][open]);
+      }
+    }
+    best.push_back(static_cast<std::size_t>(len_best));
+
+    if (len == max_length) {
+      return best;
+    }
+
+    std::ranges::fill(next, states{none, none, none});
+    for (std::size_t v = 0; v < n; ++v) {
+      const auto &adj_list = vertices[v].adj;
+      for (std::size_t k = 0; k < adj_list.size(); ++k) {
+        const auto adj = adj_list[k];
+        const std::int64_t n_induced = graph.slice_of(adj).n_induced;
+        auto &out = next[adj];
+
+        if (layer[v][not_started] != none) {
+          const auto state = n_induced == 0 ? not_started : open;
+          out[state] = std::max(out[state], n_induced);
+        }
+
+        if (layer[v][open] != none) {
+          const auto value = layer[v][open] + n_induced;
+          if (stays_open[edge_offsets[v] + k]) {
+            out[open] = std::max(out[open], value);
+          } else if (n_induced == 0 && n_groups[v] == 1) {
+            out[finished] = std::max(out[finished], value);
+          }
+        }
+
+        if (layer[v][finished] != none && n_induced == 0) {
+          out[finished] = std::max(out[finished], layer[v][finished]);
+        }
+      }
+    }
+    std::swap(layer, next);
+  }
+}
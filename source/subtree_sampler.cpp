@@ -0,0 +1,150 @@
+#include "subtree_sampler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+subtree_sampler::subtree_sampler(const subtree_zdd &zdd)
+    : subtree_sampler{zdd, std::nullopt} {}
+
+subtree_sampler::subtree_sampler(const subtree_zdd &zdd, vertex_id size)
+    : subtree_sampler{zdd, std::optional{size}} {}
+
+subtree_sampler::subtree_sampler(const subtree_zdd &zdd,
+                                 std::optional<vertex_id> size) {
+  using node_id = subtree_zdd::node_id;
+  constexpr auto always = std::numeric_limits<std::uint64_t>::max();
+  constexpr auto accept = subtree_zdd::accept;
+
+  const auto &nodes = zdd.nodes();
+  assert(nodes[accept].var < std::numeric_limits<double>::max_exponent);
+  assert(!size || *size <= zdd.max_size());
+
+  // The remaining sizes each node can have on a walk, first to last. Without
+  // a fixed size, every node has just 0, which a hi edge leaves as it is.
+  std::vector<std::int64_t> first(nodes.size(), 0), last(nodes.size(), 0);
+  last[subtree_zdd::reject] = -1;
+  const vertex_id used = size ? 1 : 0;
+  if (size) {
+    // The fewest and most vertices a walk induces after each node, and
+    // before it.
+    std::vector<std::int64_t> fewest_after(nodes.size(), 0),
+        most_after(nodes.size(), 0);
+    for (node_id id = accept + 1; id < nodes.size(); ++id) {
+      const auto &[var, lo, hi] = nodes[id];
+      fewest_after[id] = fewest_after[hi] + 1;
+      most_after[id] = most_after[hi] + 1;
+      if (lo != subtree_zdd::reject) {
+        fewest_after[id] = std::min(fewest_after[id], fewest_after[lo]);
+        most_after[id] = std::max(most_after[id], most_after[lo]);
+      }
+    }
+
+    std::vector<std::int64_t> fewest_before(nodes.size(), *size + 1),
+        most_before(nodes.size(), -1);
+    fewest_before[zdd.root()] = most_before[zdd.root()] = 0;
+    for (node_id id = zdd.root(); id > accept; --id) {
+      const auto &[var, lo, hi] = nodes[id];
+      fewest_before[lo] = std::min(fewest_before[lo], fewest_before[id]);
+      most_before[lo] = std::max(most_before[lo], most_before[id]);
+      fewest_before[hi] = std::min(fewest_before[hi], fewest_before[id] + 1);
+      most_before[hi] = std::max(most_before[hi], most_before[id] + 1);
+    }
+
+    for (node_id id = accept + 1; id < nodes.size(); ++id) {
+      first[id] = std::max(fewest_after[id], *size - most_before[id]);
+      last[id] = std::min(most_after[id], *size - fewest_before[id]);
+    }
+  }
+
+  // The weight and step of each node and remaining size are kept from the
+  // node's offset.
+  std::vector<std::size_t> offset(nodes.size() + 1, 0);
+  for (node_id id = 0; id < nodes.size(); ++id) {
+    offset[id + 1] =
+        offset[id] + static_cast<std::size_t>(std::max<std::int64_t>(
+                         last[id] - first[id] + 1, 0));
+  }
+  const auto at = [&](node_id id, std::int64_t remaining) -> std::size_t {
+    return remaining < first[id] || remaining > last[id]
+               ? offset.back()
+               : offset[id] + static_cast<std::size_t>(remaining - first[id]);
+  };
+
+  // Every node's edges lead to lower IDs, so both are weighed before it. Past
+  // the end is the weight of every size a node cannot have.
+  std::vector<double> weights(offset.back() + 1, 0.0);
+  weights[at(accept, 0)] = 1.0;
+  for (node_id id = accept + 1; id < nodes.size(); ++id) {
+    const auto &[var, lo, hi] = nodes[id];
+    for (auto r = first[id]; r <= last[id]; ++r) {
+      weights[at(id, r)] = weights[at(lo, r)] + weights[at(hi, r - used)];
+    }
+  }
+
+  // Steps are made from the bottom up, so the ones an edge leads to are
+  // already made, and any that would always take its lo edge is passed over.
+  std::vector<std::uint32_t> step_of(weights.size(), done);
+  m_steps.push_back({0, done, done, 0});
+  for (node_id id = accept + 1; id < nodes.size(); ++id) {
+    const auto &[var, lo, hi] = nodes[id];
+    for (auto r = first[id]; r <= last[id]; ++r) {
+      const auto hi_weight = weights[at(hi, r - used)];
+      if (hi_weight == 0.0) {
+        step_of[at(id, r)] = step_of[at(lo, r)];
+        continue;
+      }
+
+      const auto chance = hi_weight / weights[at(id, r)];
+      step_of[at(id, r)] = static_cast<std::uint32_t>(m_steps.size());
+      m_steps.push_back(
+          {var, step_of[at(lo, r)], step_of[at(hi, r - used)],
+           chance >= 1.0 ? always
+                         : static_cast<std::uint64_t>(std::ldexp(chance, 64))});
+    }
+  }
+  m_first = step_of[at(zdd.root(), size.value_or(0))];
+}
+
+void subtree_sampler::draw(std::mt19937_64 &rng,
+                           std::vector<vertex_id> &induced) const {
+  for (auto i = m_first; i != done;) {
+    const auto &[var, lo, hi, threshold] = m_steps[i];
+    if (threshold == std::numeric_limits<std::uint64_t>::max() ||
+        rng() < threshold) {
+      induced.push_back(var);
+      i = hi;
+    } else {
+      i = lo;
+    }
+  }
+}
+
+void subtree_sampler::draw(std::mt19937_64 &rng,
+                           std::span<std::vector<vertex_id>> induced) const {
+  std::array<std::uint32_t, n_interleaved> at;
+  assert(induced.size() <= at.size());
+  for (std::size_t j = 0; j < induced.size(); ++j) {
+    induced[j].clear();
+    at[j] = m_first;
+  }
+
+  for (auto n_walking = induced.size(); n_walking > 0;) {
+    n_walking = 0;
+    for (std::size_t j = 0; j < induced.size(); ++j) {
+      if (at[j] == done) {
+        continue;
+      }
+      const auto &[var, lo, hi, threshold] = m_steps[at[j]];
+      if (threshold == std::numeric_limits<std::uint64_t>::max() ||
+          rng() < threshold) {
+        induced[j].push_back(var);
+        at[j] = hi;
+      } else {
+        at[j] = lo;
+      }
+      n_walking += at[j] != done;
+    }
+  }
+}
@@ -0,0 +1,374 @@
+#include "subtree_zdd.hpp"
+
+#include "parallel_for.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <bitset>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+using node_id = subtree_zdd::node_id;
+
+// The component of a frontier vertex, 0 if it is not induced. Components are
+// numbered from 1 in order of first appearance, so equal states are equal.
+using label = std::uint8_t;
+
+// Given to the component a vertex joins, until the state is renumbered.
+constexpr label fresh = std::numeric_limits<label>::max();
+
+// While building, an edge is to a terminal, or to a state of the next vertex,
+// numbered from this.
+constexpr node_id first_state = 2;
+
+// The first node that is not a terminal.
+constexpr node_id first_node = 2;
+
+// The most states of one vertex, and the most nodes, that IDs can number. The
+// largest ID is left for the unique table to mark empty slots with.
+constexpr node_id max_states =
+    std::numeric_limits<node_id>::max() - first_state;
+constexpr node_id max_nodes = std::numeric_limits<node_id>::max();
+
+/**
+ * @brief A unique table, which finds the item equal to a new one among those
+ * added so far, by linear probing over their indexes. It is sized for the most
+ * items it will hold, and kept at most half full.
+ */
+class unique_table {
+public:
+  explicit unique_table(std::size_t max_items)
+      : m_slots(std::bit_ceil(std::max<std::size_t>(2 * max_items, 2))) {}
+
+  /**
+   * @brief Finds the item equal to a new one, adding the new one if there is
+   * none.
+   * @param hash The hash of the new item
+   * @param index The index of the new item
+   * @param equal Gets whether the item at an index is equal to the new one
+   * @return The index of the equal item, or index if there was none
+   */
+  template <std::predicate<std::uint32_t> TEqual>
+  std::uint32_t find_or_add(std::size_t hash, std::uint32_t index,
+                            TEqual &&equal) {
+    const auto short_hash = static_cast<std::uint32_t>(hash);
+    const auto mask = m_slots.size() - 1;
+    for (auto i = hash & mask;; i = (i + 1) & mask) {
+      auto &entry = m_slots[i];
+      if (entry.index == empty) {
+        entry = {index, short_hash};
+        return index;
+      }
+      if (entry.hash == short_hash && equal(entry.index)) {
+        return entry.index;
+      }
+    }
+  }
+
+private:
+  constexpr static std::uint32_t empty =
+      std::numeric_limits<std::uint32_t>::max();
+
+  struct slot {
+    std::uint32_t index{empty};
+    std::uint32_t hash{0};
+  };
+
+  std::vector<slot> m_slots;
+};
+
+/**
+ * @brief Decides a vertex for a partial subtree.
+ * @param state The state of the partial subtree, oldest frontier vertex first
+ * @param back The index in the frontier of each neighbor decided before it
+ * @param induce Whether the vertex is induced
+ * @param last Whether this is the last vertex
+ * @param next Set to the state after, with the oldest vertex gone from the
+ * frontier and this one added
+ * @return reject or accept if every completion is the same, or first_state if
+ * that depends on next
+ */
+node_id step(std::span<const label> state, std::span<const std::size_t> back,
+             bool induce, bool last, std::span<label> next) {
+  std::copy(state.begin() + 1, state.end(), next.begin());
+  next.back() = 0;
+
+  // The components the vertex joins, each of which it can only touch once,
+  // or it would close a cycle.
+  std::bitset<fresh> joined;
+  if (induce) {
+    for (const auto i : back) {
+      if (state[i] == 0) {
+        continue;
+      }
+      if (joined[state[i]]) {
+        return subtree_zdd::reject;
+      }
+      joined[state[i]] = true;
+    }
+
+    for (auto &c : next) {
+      if (c != 0 && joined[c]) {
+        c = fresh;
+      }
+    }
+    next.back() = fresh;
+  }
+
+  // No later vertex can touch the one leaving the frontier. If nothing else in
+  // its component is left either, it is the whole subtree, so nothing else can
+  // be induced.
+  const auto leaving = state.front();
+  if (leaving != 0 && !joined[leaving] &&
+      std::ranges::find(next, leaving) == next.end()) {
+    return std::ranges::all_of(next, [](label c) { return c == 0; })
+               ? subtree_zdd::accept
+               : subtree_zdd::reject;
+  }
+
+  if (last) {
+    // Whatever is left on the frontier must be one component.
+    label only = 0;
+    for (const auto c : next) {
+      if (c != 0 && only != 0 && c != only) {
+        return subtree_zdd::reject;
+      }
+      only = std::max(only, c);
+    }
+    return subtree_zdd::accept;
+  }
+
+  std::array<label, fresh + 1> renumber{};
+  label n_comps = 0;
+  for (auto &c : next) {
+    if (c != 0) {
+      if (renumber[c] == 0) {
+        renumber[c] = ++n_comps;
+      }
+      c = renumber[c];
+    }
+  }
+  return first_state;
+}
+
+} // namespace
+
+subtree_zdd::subtree_zdd(const graph_type &graph, unsigned n_threads)
+    : m_graph{graph} {
+  const auto n_vertices = static_cast<vertex_id>(graph.vertices.size());
+  m_nodes.push_back({n_vertices, reject, reject});
+  m_nodes.push_back({n_vertices, accept, accept});
+  m_root = accept;
+
+  if (n_vertices == 0) {
+    return;
+  }
+
+  // The most recent vertices that later ones can touch, the farthest of
+  // which is one step back in the last dimension.
+  const auto &dims = graph.dims_array;
+  const std::size_t width =
+      dims.empty() ? 1 : graph.size_of_dim(dims.size() - 1);
+  assert(width < fresh);
+
+  // The lo and hi edge of each state of each vertex.
+  std::vector<std::vector<std::array<node_id, 2>>> layers(n_vertices);
+
+  // The states of the current vertex, one after another. Before the first
+  // vertex, there is just the state with nothing induced.
+  std::vector<label> states(width, 0), next_states, found;
+  std::vector<std::size_t> back;
+
+  for (vertex_id v = 0; v < n_vertices; ++v) {
+    back.clear();
+    for (const auto u : graph.vertices[v].neighbors) {
+      if (u < v) {
+        back.push_back(width - (v - u));
+      }
+    }
+
+    const bool last = v + 1 == n_vertices;
+    const std::size_t n_states = states.size() / width;
+    auto &edges = layers[v];
+    edges.resize(n_states);
+    found.resize(2 * n_states * width);
+
+    parallel_for(
+        n_states,
+        [&](std::size_t s) {
+          const std::span<const label> state{states.data() + s * width, width};
+          for (const bool induce : {false, true}) {
+            const std::span<label> next{
+                found.data() + (2 * s + induce) * width, width};
+            edges[s][induce] = step(state, back, induce, last, next);
+          }
+        },
+        n_threads);
+
+    // States are numbered in the order they are first found, so the diagram
+    // is the same however many threads found them.
+    unique_table unique{2 * n_states};
+    std::uint32_t n_next = 0;
+    next_states.clear();
+    for (std::size_t s = 0; s < n_states; ++s) {
+      for (const bool induce : {false, true}) {
+        auto &edge = edges[s][induce];
+        if (edge != first_state) {
+          continue;
+        }
+
+        const std::span<const label> next{
+            found.data() + (2 * s + induce) * width, width};
+        const auto hash = std::hash<std::string_view>{}(
+            {reinterpret_cast<const char *>(next.data()), width});
+        const auto index = unique.find_or_add(hash, n_next, [&](std::uint32_t i) {
+          return std::ranges::equal(
+              next, std::span{next_states}.subspan(i * width, width));
+        });
+        if (index == n_next) {
+          if (n_next == max_states) {
+            throw std::length_error{
+                "subtree_zdd: too many states to number with 32 bits"};
+          }
+          next_states.insert(next_states.end(), next.begin(), next.end());
+          ++n_next;
+        }
+        edge = first_state + index;
+      }
+    }
+    std::swap(states, next_states);
+  }
+
+  // Reduce from the last vertex back. Each state becomes a node, unless a
+  // node with the same edges has already been made for this vertex, or it
+  // would never induce its vertex.
+  std::vector<node_id> reduced, reduced_before;
+  for (vertex_id v = n_vertices; v-- > 0;) {
+    const auto &edges = layers[v];
+    const auto target = [&reduced](node_id edge) {
+      return edge < first_state ? edge : reduced[edge - first_state];
+    };
+
+    reduced_before.resize(edges.size());
+    unique_table merged{edges.size()};
+    for (std::size_t s = 0; s < edges.size(); ++s) {
+      const auto lo = target(edges[s][0]);
+      const auto hi = target(edges[s][1]);
+      if (hi == reject) {
+        reduced_before[s] = lo;
+        continue;
+      }
+
+      if (m_nodes.size() == max_nodes) {
+        throw std::length_error{
+            "subtree_zdd: too many nodes to number with 32 bits"};
+      }
+
+      // The high bits of the product depend on every bit of the edges.
+      const auto product = ((std::uint64_t{lo} << 32) | hi) * 0x9E3779B97F4A7C15;
+      const auto id = static_cast<node_id>(m_nodes.size());
+      const auto same = merged.find_or_add(
+          product >> 32, id, [&](std::uint32_t other) {
+            return m_nodes[other].lo == lo && m_nodes[other].hi == hi;
+          });
+      if (same == id) {
+        m_nodes.push_back({v, lo, hi});
+      }
+      reduced_before[s] = same;
+    }
+
+    std::swap(reduced, reduced_before);
+    layers[v] = {};
+  }
+  m_root = reduced.front();
+}
+
+std::vector<big_uint> subtree_zdd::count_by_size() const {
+  // No count is more than 2^n, so each is added as this many 32 bit limbs,
+  // least significant first, rather than as a big_uint.
+  const std::size_t n_limbs = m_nodes[accept].var / 32 + 1;
+
+  std::vector<std::uint32_t> by_size;
+
+  // The number of paths from the root to each node, by how many vertices
+  // they induce. Every node's edges lead to lower IDs, so all of a node's
+  // paths are counted before it is reached.
+  std::vector<std::vector<std::uint32_t>> paths(m_nodes.size());
+  const auto add_paths = [&](node_id to, const std::vector<std::uint32_t> &counts,
+                             std::size_t n_induced) {
+    if (to == reject) {
+      return;
+    }
+
+    auto &sums = (to == accept) ? by_size : paths[to];
+    const auto offset = n_induced * n_limbs;
+    if (sums.size() < counts.size() + offset) {
+      sums.resize(counts.size() + offset);
+    }
+    for (std::size_t k = 0; k < counts.size(); k += n_limbs) {
+      std::uint64_t carry = 0;
+      for (std::size_t l = 0; l < n_limbs; ++l) {
+        carry += std::uint64_t{sums[offset + k + l]} + counts[k + l];
+        sums[offset + k + l] = static_cast<std::uint32_t>(carry);
+        carry >>= 32;
+      }
+    }
+  };
+
+  std::vector<std::uint32_t> one(n_limbs);
+  one.front() = 1;
+  add_paths(m_root, one, 0);
+  for (node_id id = m_root; id >= first_node; --id) {
+    std::vector<std::uint32_t> counts;
+    counts.swap(paths[id]);
+    if (!counts.empty()) {
+      add_paths(m_nodes[id].lo, counts, 0);
+      add_paths(m_nodes[id].hi, counts, 1);
+    }
+  }
+
+  std::vector<big_uint> result;
+  for (std::size_t k = 0; k < by_size.size(); k += n_limbs) {
+    result.emplace_back(std::span{by_size}.subspan(k, n_limbs));
+  }
+  return result;
+}
+
+vertex_id subtree_zdd::max_size() const {
+  return static_cast<vertex_id>(max_sizes()[m_root]);
+}
+
+subtree_type subtree_zdd::max_subtree() const {
+  const auto best = max_sizes();
+
+  std::vector<vertex_id> induced;
+  for (node_id id = m_root; id != accept;) {
+    const auto &[var, lo, hi] = m_nodes[id];
+    if (best[hi] + 1 == best[id]) {
+      induced.push_back(var);
+      id = hi;
+    } else {
+      id = lo;
+    }
+  }
+
+  return induced.empty() ? subtree_type{m_graph}
+                         : subtree_type{m_graph, induced};
+}
+
+std::vector<std::int32_t> subtree_zdd::max_sizes() const {
+  std::vector<std::int32_t> best(m_nodes.size(), -1);
+  best[accept] = 0;
+  for (node_id id = first_node; id < m_nodes.size(); ++id) {
+    const auto &[var, lo, hi] = m_nodes[id];
+    best[id] = std::max(best[lo], best[hi] < 0 ? -1 : best[hi] + 1);
+  }
+  return best;
+}
@@ -0,0 +1,147 @@
+#include "upper_bound.hpp"
+
+#include "slice_graph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Gets a box as a prism along its longest dimension. Dimensions of 1
+ * are dropped from the cross-section, as they do not change its graph, and the
+ * rest are sorted, so every box with the same cross-section shares its graph.
+ * @param box The dimensions of the box, none of which are 0
+ * @return The cross-section and length of the prism
+ */
+std::pair<std::vector<std::size_t>, std::size_t>
+as_prism(std::span<const std::size_t> box) {
+  std::vector<std::size_t> cross_section;
+  std::ranges::copy_if(box, std::back_inserter(cross_section),
+                       [](std::size_t d) { return d > 1; });
+  std::ranges::sort(cross_section);
+
+  if (cross_section.empty()) {
+    return {cross_section, 1};
+  }
+
+  const auto length = cross_section.back();
+  cross_section.pop_back();
+  return {cross_section, length};
+}
+
+// Adds two bounds, giving the largest size_t instead of overflowing.
+std::size_t saturating_add(std::size_t a, std::size_t b) {
+  return (a > std::numeric_limits<std::size_t>::max() - b)
+             ? std::numeric_limits<std::size_t>::max()
+             : a + b;
+}
+
+} // namespace
+
+upper_bound_table::upper_bound_table(std::span<const std::size_t> dims,
+                                     std::size_t max_slice_cells)
+    : m_dims(dims.begin(), dims.end()) {
+  std::size_t n_boxes = 1;
+  for (const auto d : m_dims) {
+    m_strides.push_back(n_boxes);
+    n_boxes *= d + 1;
+  }
+
+  const auto box_at = [this](std::size_t i, std::vector<std::size_t> &box) {
+    for (std::size_t d = 0; d < m_dims.size(); ++d) {
+      box[d] = (i / m_strides[d]) % (m_dims[d] + 1);
+    }
+  };
+
+  std::vector<std::size_t> box(m_dims.size());
+
+  // The longest prism needed for each cross-section small enough to build
+  // a slice graph for. Each graph is walked once, for every length. The
+  // cross-section of a single cell, that of every line, is always solved,
+  // so that every box can be cut into solved ones.
+  std::map<std::vector<std::size_t>, std::size_t> max_lengths;
+  for (std::size_t i = 0; i < n_boxes; ++i) {
+    box_at(i, box);
+    if (std::ranges::find(box, 0) != box.end()) {
+      continue;
+    }
+
+    const auto [cross_section, length] = as_prism(box);
+    const auto n_cells =
+        std::reduce(cross_section.begin(), cross_section.end(),
+                    std::size_t{1}, std::multiplies<>{});
+    if (n_cells <= std::max(max_slice_cells, std::size_t{1})) {
+      auto &max_length = max_lengths[cross_section];
+      max_length = std::max(max_length, length);
+    }
+  }
+
+  std::map<std::vector<std::size_t>, std::vector<std::size_t>> max_forests;
+  for (const auto &[cross_section, max_length] : max_lengths) {
+    max_forests.emplace(
+        cross_section,
+        max_prism_forests(slice_graph::get(cross_section, true), max_length));
+  }
+
+  // Both parts of a cut have a lower index than the box cut, so each box
+  // is found after every box it can be cut into.
+  m_bounds.resize(n_boxes);
+  m_cuts.resize(n_boxes);
+  for (std::size_t i = 0; i < n_boxes; ++i) {
+    box_at(i, box);
+    if (std::ranges::find(box, 0) != box.end()) {
+      continue;
+    }
+
+    auto &bound = m_bounds[i];
+    bound = std::numeric_limits<std::size_t>::max();
+
+    const auto [cross_section, length] = as_prism(box);
+    if (const auto it = max_forests.find(cross_section);
+        it != max_forests.end()) {
+      bound = it->second[length];
+    }
+
+    // Cutting off at most half of a dimension tries every cut once.
+    for (std::size_t d = 0; d < box.size(); ++d) {
+      for (std::size_t at = 1; 2 * at <= box[d]; ++at) {
+        const auto sum =
+            saturating_add(m_bounds[i - (box[d] - at) * m_strides[d]],
+                           m_bounds[i - at * m_strides[d]]);
+        if (sum < bound) {
+          bound = sum;
+          m_cuts[i] = {static_cast<std::uint8_t>(d), at};
+        }
+      }
+    }
+  }
+}
+
+std::vector<std::vector<std::size_t>>
+upper_bound_table::slabs(std::span<const std::size_t> box) const {
+  const auto [dim, at] = m_cuts[index(box)];
+  if (dim == cut::no_cut) {
+    return {{box.begin(), box.end()}};
+  }
+
+  std::vector<std::size_t> part(box.begin(), box.end());
+  part[dim] = at;
+  auto result = slabs(part);
+
+  part[dim] = box[dim] - at;
+  auto rest = slabs(part);
+  result.insert(result.end(), std::make_move_iterator(rest.begin()),
+                std::make_move_iterator(rest.end()));
+  return result;
+}
+
+std::size_t upper_bound_table::index(std::span<const std::size_t> box) const {
+  return std::inner_product(box.begin(), box.end(), m_strides.begin(),
+                            std::size_t{0});
+}
@@ -0,0 +1,50 @@
+#include "defs.hpp"
+#include "graph.hpp"
+#include "subTree.hpp"
+#include "localSearch.hpp"
+
+#include <iostream>
+
+// Reads a subtree from a result file, then runs a local search on it
+// with every thread, writing any improvement to the output file.
+int main(int num_args, char** args)
+{
+	if (num_args != 3 && num_args != 4)
+	{
+		std::cerr << "usage: " << args[0] << " <infile> <outfile> [seconds]" << std::endl;
+		exit(1);
+	}
+
+	std::vector<Graph::vertexID> vertices;
+	if (!localSearch::readFromFile(args[1], vertices) || vertices.empty())
+	{
+		std::cerr << "could not read a subtree of this size from " << args[1] << std::endl;
+		exit(1);
+	}
+
+	defs::outfile = args[2];
+	defs::start_time = clock();
+
+	const Subtree start = localSearch::build(vertices);
+	if (start.numInduced != vertices.size())
+	{
+		std::cerr << "warning: only " << start.numInduced << " of the "
+			<< vertices.size() << " vertices form an induced tree" << std::endl;
+	}
+
+	defs::checkCandidate(start);
+
+	localSearch::options opts;
+	opts.numThreads = defs::NUM_THREADS;
+	opts.seed = time(NULL);
+	if (num_args == 4)
+	{
+		opts.seconds = std::stod(args[3]);
+	}
+
+	const Subtree best = localSearch::improve(start, opts);
+
+	std::cout << "Local search result = " << best.numInduced << std::endl;
+
+	std::clog << "Largest size (no enclosed space) = " << defs::largestTree << std::endl;
+}
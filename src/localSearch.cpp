@@ -0,0 +1,433 @@
+#include "localSearch.hpp"
+#include "defs.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <queue>
+#include <random>
+#include <sstream>
+
+namespace
+{
+	using vertexID = Graph::vertexID;
+
+	// A set of vertices with constant time insertion, removal, and uniform
+	// random selection.
+	class vertexPool
+	{
+		public:
+
+		vertexPool() { position.fill(Graph::EMPTY); }
+
+		void set(vertexID x, bool inPool)
+		{
+			if (inPool && position[x] == Graph::EMPTY)
+			{
+				position[x] = static_cast<vertexID>(items.size());
+				items.push_back(x);
+			}
+			else if (!inPool && position[x] != Graph::EMPTY)
+			{
+				items[position[x]] = items.back();
+				position[items.back()] = position[x];
+				items.pop_back();
+				position[x] = Graph::EMPTY;
+			}
+		}
+
+		[[nodiscard]] bool empty() const { return items.empty(); }
+
+		[[nodiscard]] vertexID random(std::mt19937_64& rng) const
+		{
+			return items[std::uniform_int_distribution<std::size_t>(0, items.size() - 1)(rng)];
+		}
+
+		private:
+
+		std::vector<vertexID> items;
+		std::array<vertexID, Graph::numVertices> position;
+	};
+
+	using clock_type = std::chrono::steady_clock;
+
+	// The state of the search in one thread.
+	class search
+	{
+		public:
+
+		search(const Subtree& start, const localSearch::options& opts_, unsigned index) :
+			S(start), best(start), opts(opts_),
+			rng(opts_.seed ^ (0x9E3779B97F4A7C15ull * (index + 1))), tabuUntil()
+		{
+			for (vertexID x = 0; x < Graph::numVertices; ++x)
+			{
+				refresh(x);
+			}
+		}
+
+		Subtree run(clock_type::time_point deadline)
+		{
+			const auto start = clock_type::now();
+			const double budget = std::chrono::duration<double>(deadline - start).count();
+			double temperature = opts.startTemperature;
+
+			while (true)
+			{
+				// Checking the clock is comparatively slow, do it only
+				// every so often.
+				if (step % 256 == 0)
+				{
+					const auto now = clock_type::now();
+					if (now >= deadline) break;
+
+					const double elapsed = std::chrono::duration<double>(now - start).count();
+					temperature = opts.startTemperature * std::pow(
+						opts.endTemperature / opts.startTemperature, elapsed / budget);
+				}
+				++step;
+
+				switch (rng() % 4)
+				{
+					case 0: addLeaf(); break;
+					case 1: swapOneForTwo(); break;
+					case 2: shiftBranch(); break;
+					case 3:
+						if (std::uniform_real_distribution<double>(0, 1)(rng)
+							< std::exp(-1 / temperature))
+						{
+							removeLeaf();
+						}
+						break;
+				}
+
+				if (S.numInduced > best.numInduced)
+				{
+					best = S;
+					if (S.numInduced > defs::largestTree)
+					{
+						defs::checkCandidate(S);
+					}
+				}
+				else if (S.numInduced + opts.restartGap <= best.numInduced)
+				{
+					restart();
+				}
+			}
+
+			return best;
+		}
+
+		private:
+
+		Subtree S, best;
+
+		const localSearch::options& opts;
+
+		std::mt19937_64 rng;
+
+		// Induced vertices with one induced neighbor.
+		vertexPool leaves;
+
+		// Vertices not induced with exactly one induced neighbor, these
+		// can be added as leaves if they preserve the neighbor condition.
+		vertexPool frontier;
+
+		// Vertices not induced with exactly two induced neighbors, adding
+		// one of these closes a cycle.
+		vertexPool chords;
+
+		std::array<uint64_t, Graph::numVertices> tabuUntil;
+		uint64_t step = 0;
+
+		// Used by findCycle, kept here to avoid reallocating.
+		std::array<vertexID, Graph::numVertices> parent;
+		std::queue<vertexID> toVisit;
+		std::vector<vertexID> cycle;
+
+		bool isTabu(vertexID x) const { return tabuUntil[x] > step; }
+
+		// Updates which pools x is in.
+		void refresh(vertexID x)
+		{
+			leaves  .set(x,  S.has(x) && S.cnt(x) == 1);
+			frontier.set(x, !S.has(x) && S.cnt(x) == 1);
+			chords  .set(x, !S.has(x) && S.cnt(x) == 2);
+		}
+
+		// Updates the pools after x is added or removed.
+		void touch(vertexID x)
+		{
+			refresh(x);
+			for (vertexID y : Graph::vertices[x].neighbors)
+			{
+				refresh(y);
+			}
+		}
+
+		bool tryAdd(vertexID x)
+		{
+			if (S.has(x) || S.cnt(x) != 1 || isTabu(x) || !S.safeToAdd(x))
+				return false;
+
+			S.add(x);
+			touch(x);
+			return true;
+		}
+
+		void remove(vertexID x)
+		{
+			S.rem(x);
+			touch(x);
+			tabuUntil[x] = step + opts.tabuTenure;
+		}
+
+		void addLeaf()
+		{
+			if (!frontier.empty())
+			{
+				tryAdd(frontier.random(rng));
+			}
+		}
+
+		void removeLeaf()
+		{
+			if (!leaves.empty())
+			{
+				remove(leaves.random(rng));
+			}
+		}
+
+		// Tries to add a leaf within distance two of x, other than skip.
+		// Returns the vertex added, or EMPTY if none could be.
+		vertexID addNear(vertexID x, vertexID skip)
+		{
+			for (vertexID y : Graph::vertices[x].neighbors)
+			{
+				if (y != skip && tryAdd(y)) return y;
+
+				for (vertexID z : Graph::vertices[y].neighbors)
+				{
+					if (z != skip && tryAdd(z)) return z;
+				}
+			}
+			return Graph::EMPTY;
+		}
+
+		void swapOneForTwo()
+		{
+			if (leaves.empty()) return;
+
+			const vertexID u = leaves.random(rng);
+			S.rem(u);
+			touch(u);
+
+			// Anything that can be added now was blocked by u, so will be
+			// next to it. The second leaf can also be next to the first.
+			const vertexID a = addNear(u, u);
+			if (a != Graph::EMPTY)
+			{
+				vertexID b = addNear(u, u);
+				if (b == Graph::EMPTY) b = addNear(a, u);
+
+				if (b != Graph::EMPTY)
+				{
+					tabuUntil[u] = step + opts.tabuTenure;
+					return;
+				}
+
+				S.rem(a);
+				touch(a);
+			}
+
+			S.add(u);
+			touch(u);
+		}
+
+		// Finds the path from a to b through induced vertices other than
+		// skip, and stores it in cycle. Assumes there is exactly one.
+		void findCycle(vertexID a, vertexID b, vertexID skip)
+		{
+			parent[a] = a;
+			parent[skip] = skip;
+			std::array<bool, Graph::numVertices> seen {};
+			seen[a] = seen[skip] = true;
+
+			toVisit = {};
+			toVisit.push(a);
+			while (!toVisit.empty())
+			{
+				const vertexID x = toVisit.front();
+				toVisit.pop();
+
+				if (x == b) break;
+
+				for (vertexID y : Graph::vertices[x].neighbors)
+				{
+					if (S.has(y) && !seen[y])
+					{
+						seen[y] = true;
+						parent[y] = x;
+						toVisit.push(y);
+					}
+				}
+			}
+
+			cycle.clear();
+			for (vertexID x = b; x != a; x = parent[x])
+			{
+				cycle.push_back(x);
+			}
+			cycle.push_back(a);
+		}
+
+		void shiftBranch()
+		{
+			if (chords.empty()) return;
+
+			const vertexID v = chords.random(rng);
+			if (isTabu(v)) return;
+
+			S.join(v);
+
+			// Only the two induced neighbors have a changed degree, so
+			// only they can break the neighbor condition.
+			vertexID ends[2];
+			unsigned numEnds = 0;
+			bool valid = true;
+			for (vertexID y : Graph::vertices[v].neighbors)
+			{
+				if (S.has(y))
+				{
+					ends[numEnds++] = y;
+					valid = valid && S.validate(y);
+				}
+			}
+
+			if (valid)
+			{
+				findCycle(ends[0], ends[1], v);
+
+				// A vertex of the cycle can be removed without
+				// disconnecting the tree only if nothing else hangs off it.
+				std::erase_if(cycle, [this](vertexID x) { return S.cnt(x) != 2; });
+
+				if (!cycle.empty())
+				{
+					touch(v);
+					remove(cycle[std::uniform_int_distribution<std::size_t>(
+						0, cycle.size() - 1)(rng)]);
+					return;
+				}
+			}
+
+			S.rem(v);
+		}
+
+		void restart()
+		{
+			S = best;
+			for (vertexID x = 0; x < Graph::numVertices; ++x)
+			{
+				refresh(x);
+			}
+		}
+	};
+
+	Subtree runSearch(int, const Subtree& start, const localSearch::options& opts,
+		unsigned index, clock_type::time_point deadline)
+	{
+		return search(start, opts, index).run(deadline);
+	}
+}
+
+bool localSearch::readFromFile(const std::string& filename, std::vector<Graph::vertexID>& vertices)
+{
+	std::ifstream file(filename);
+
+	// The first line has the dimensions
+	std::string line;
+	if (!std::getline(file, line)) return false;
+
+	std::istringstream dimStream(line);
+	std::vector<unsigned> dims;
+	for (unsigned d; dimStream >> d;)
+	{
+		dims.push_back(d);
+	}
+
+	const auto expected = std::to_array<unsigned>({ SIZE });
+	if (!std::equal(dims.begin(), dims.end(), expected.begin(), expected.end()))
+		return false;
+
+	// Then one character per vertex, possibly split across lines
+	vertices.clear();
+	Graph::vertexID x = 0;
+	for (char c; x < Graph::numVertices && file >> c; )
+	{
+		if (c == 'X') vertices.push_back(x++);
+		else if (c == '_') ++x;
+		else return false;
+	}
+
+	return x == Graph::numVertices;
+}
+
+Subtree localSearch::build(const std::vector<Graph::vertexID>& vertices)
+{
+	std::array<bool, Graph::numVertices> wanted {};
+	for (Graph::vertexID x : vertices)
+	{
+		wanted[x] = true;
+	}
+
+	// Add the vertices in breadth-first order, so each is a leaf when added.
+	Subtree S(vertices.front());
+	std::queue<Graph::vertexID> toVisit;
+	toVisit.push(vertices.front());
+	while (!toVisit.empty())
+	{
+		const Graph::vertexID x = toVisit.front();
+		toVisit.pop();
+
+		for (Graph::vertexID y : Graph::vertices[x].neighbors)
+		{
+			if (wanted[y] && !S.has(y) && S.add(y))
+			{
+				toVisit.push(y);
+			}
+		}
+	}
+
+	return S;
+}
+
+Subtree localSearch::improve(const Subtree& start, const options& opts)
+{
+	const auto deadline = clock_type::now() +
+		std::chrono::duration_cast<clock_type::duration>(std::chrono::duration<double>(opts.seconds));
+
+	if (opts.numThreads <= 1)
+	{
+		return search(start, opts, 0).run(deadline);
+	}
+
+	std::vector<std::future<Subtree>> results;
+	for (unsigned i = 0; i < opts.numThreads; ++i)
+	{
+		results.push_back(defs::pool.push(runSearch, std::cref(start), std::cref(opts), i, deadline));
+	}
+
+	Subtree best = start;
+	for (auto& result : results)
+	{
+		Subtree S = result.get();
+		if (S.numInduced > best.numInduced)
+		{
+			best = S;
+		}
+	}
+	return best;
+}
@@ -0,0 +1,68 @@
+#ifndef LOCAL_SEARCH_HPP
+#define LOCAL_SEARCH_HPP
+
+#include "graph.hpp"
+#include "subTree.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+Local search improves an induced subtree that has already been found, by
+repeatedly applying small moves that keep it an induced subtree:
+
+- Add a leaf: add a vertex with exactly one induced neighbor (+1).
+- Swap one for two: remove a leaf, then add two leaves near it (+1).
+- Shift a branch: add a vertex with two induced neighbors, closing a cycle,
+  then remove another vertex of that cycle with no other branches (+0).
+- Remove a leaf (-1), accepted with a probability given by the temperature.
+
+The moves are chosen at random, and accepted as in simulated annealing, with
+the temperature falling over the time budget. Removed vertices are tabu for
+a few steps so they are not immediately added back. Every thread runs its own
+search from the same starting tree, and every result larger than the largest
+seen so far is passed to defs::checkCandidate.
+*/
+
+namespace localSearch
+{
+	struct options
+	{
+		// Wall clock time to search for, in seconds.
+		double seconds = 1;
+
+		unsigned numThreads = 1;
+
+		// Each thread's random number generator is seeded from this and
+		// its index, so a search is reproducible for a single thread.
+		uint64_t seed = 0;
+
+		// The temperature falls exponentially between these values.
+		// At temperature T, a leaf is removed with probability exp(-1/T).
+		double startTemperature = 0.6;
+		double endTemperature = 0.05;
+
+		// Number of steps a removed vertex cannot be added back for.
+		unsigned tabuTenure = 8;
+
+		// If the current tree falls this many vertices below the best
+		// found by its thread, the thread restarts from that best.
+		unsigned restartGap = 4;
+	};
+
+	// Reads the vertices of a subtree from a file in the format written
+	// by Subtree::writeToFile. Returns false if the file cannot be read or
+	// is for a graph of different dimensions.
+	bool readFromFile(const std::string& filename, std::vector<Graph::vertexID>& vertices);
+
+	// Builds a subtree from a set of vertices that form an induced tree.
+	// The vertices may be given in any order.
+	Subtree build(const std::vector<Graph::vertexID>& vertices);
+
+	// Searches for larger trees around start until the time budget
+	// expires, and returns the largest found.
+	Subtree improve(const Subtree& start, const options& opts);
+}
+
+#endif
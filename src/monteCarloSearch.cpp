@@ -2,25 +2,92 @@
 #include "graph.hpp"
 #include "subTree.hpp"
 #include "indexedList.hpp"
+#include "transpositionTable.hpp"
+#include "localSearch.hpp"
+#include "playout.hpp"
 
 #include <stack>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <optional>
 #include <random>
 
-// Updates the border of S after adding x, does not track changes.
-void simpleUpdate(Subtree& S,
-	indexedList<Graph::vertexID, Graph::numVertices>& border, Graph::vertexID x)
+// Caches the results of nested searches, shared by all levels.
+TranspositionTable table;
+
+// Size of the transposition table, if not given on the command line.
+constexpr std::size_t DEFAULT_TABLE_MB = 256;
+
+// Every new largest tree is polished with a short local search, if the
+// time given for it is not 0.
+localSearch::options polish { .seconds = 0 };
+
+// The level of the search currently running. This is NMC_LEVEL unless a time
+// budget is given, in which case the level is increased as time allows.
+unsigned topLevel = NMC_LEVEL;
+
+using clock_type = std::chrono::steady_clock;
+
+// When this is reached, every search stops as soon as its current playout
+// finishes, and outOfTime is set.
+clock_type::time_point deadline = clock_type::time_point::max();
+bool outOfTime = false;
+
+// If true, each vertex the top level decides on is printed.
+bool showDecisions = true;
+
+// Level 0 playouts for each thread, if the graph is small enough to use them.
+std::vector<BitboardPlayouts> batches(BitboardPlayouts::supported ? defs::NUM_THREADS : 0);
+
+// One random key per vertex for the border, so a vertex in the border
+// changes the state's hash differently than if it were induced.
+const std::array<uint64_t, Graph::numVertices> borderKeys = []
 {
-	for (Graph::vertexID y : Graph::vertices[x].neighbors)
+	std::mt19937_64 generator(0xD1B54A32D192ED03ull);
+	
+	std::array<uint64_t, Graph::numVertices> keys;
+	for (uint64_t& key : keys)
 	{
-		if (S.cnt(y) > 1)
-		{
-			border.remove(y);
-		}
-		else if (y > S.root && !S.has(y))
-		{
-			border.push_front(y);
-		}
+		key = generator();
+	}
+	return keys;
+}();
+
+// The hash of a search state, which is both the induced vertices and the
+// border. The same vertices can be reached with different borders, since
+// each search removes the vertices its earlier siblings tried from the
+// border it passes down, and those searches try different vertices.
+uint64_t stateHash(const Subtree& S,
+	indexedList<Graph::vertexID, Graph::numVertices>& border)
+{
+	uint64_t hash = S.hash;
+	for (Graph::vertexID x : border)
+	{
+		hash ^= borderKeys[x];
+	}
+	return hash;
+}
+
+// Passes S to checkCandidate, then polishes it if it was a new best.
+void reportCandidate(const Subtree& S)
+{
+	defs::checkCandidate(S);
+	
+	if (polish.seconds <= 0 || S.numInduced != defs::largestTree) return;
+	
+	// A time budget covers polishing too, so never polish past the deadline.
+	localSearch::options opts = polish;
+	if (deadline != clock_type::time_point::max())
+	{
+		opts.seconds = std::min(opts.seconds,
+			std::chrono::duration<double>(deadline - clock_type::now()).count());
+	}
+	
+	// Any improvement is written by checkCandidate.
+	if (opts.seconds > 0)
+	{
+		localSearch::improve(S, opts);
 	}
 }
 
@@ -31,31 +98,19 @@ void randomBranch(int id, Subtree S, indexedList<Graph::vertexID, Graph::numVert
 	unsigned& bestResult, indexedList<Graph::vertexID, Graph::numVertices> currentPath,
 	indexedList<Graph::vertexID, Graph::numVertices>& bestPath)
 {
-	while(!border.empty())
-	{
-		Graph::vertexID x;
-		do
-		{
-			// Get and remove a random element,
-			// ensure it is valid.
-			x = border.removeRandom();
-		}
-		while (!S.safeToAdd(x) && !border.empty());
-		
-		// Check for this, not the empty border.
-		if (!S.add(x)) break;
-		
-		simpleUpdate(S,border,x);
-		
-		currentPath.push_back(x);
-	}
+	randomPlayout(S,border,currentPath);
 	
 	if (S.numInduced > defs::largestTree)
 	{
-		defs::checkCandidate(S);
+		reportCandidate(S);
 	}
 	++defs::numLeaves[id];
 	
+	if (clock_type::now() >= deadline)
+	{
+		outOfTime = true;
+	}
+	
 	if (S.numInduced > bestResult)
 	{
 		bestResult = S.numInduced;
@@ -63,14 +118,76 @@ void randomBranch(int id, Subtree S, indexedList<Graph::vertexID, Graph::numVert
 	}
 }
 
+// Runs the playouts in this thread's batch, which all start from S with one
+// vertex added. Keeps the best result and path as randomBranch does.
+void runBatch(int id, const Subtree& S, unsigned& bestResult,
+	indexedList<Graph::vertexID, Graph::numVertices>& bestPath)
+{
+	BitboardPlayouts& batch = batches[id];
+	batch.run();
+	
+	for (unsigned i = 0; i < batch.numPlayouts(); ++i)
+	{
+		const unsigned result = batch.result(i);
+		
+		if (result > defs::largestTree)
+		{
+			Subtree T = S;
+			for (Graph::vertexID x : batch.path(i))
+			{
+				T.add(x);
+			}
+			reportCandidate(T);
+		}
+		++defs::numLeaves[id];
+		
+		if (result > bestResult)
+		{
+			bestResult = result;
+			bestPath = {};
+			for (Graph::vertexID x : batch.path(i))
+			{
+				bestPath.push_back(x);
+			}
+		}
+	}
+	
+	if (clock_type::now() >= deadline)
+	{
+		outOfTime = true;
+	}
+}
+
 void nested_monte_carlo(int id, Subtree& S,
 	indexedList<Graph::vertexID, Graph::numVertices>& border,
 	std::stack<defs::action>& previous_actions, unsigned level, unsigned& globalBestResult,
 	indexedList<Graph::vertexID, Graph::numVertices> currentPath,
 	indexedList<Graph::vertexID, Graph::numVertices>& globalBestPath)
 {
-	// Keep track of the vertices added.
-	std::stack<Graph::vertexID> added;
+	// If this state has already been searched at this level, reuse that result.
+	// The top level is only ever searched once, so don't bother looking.
+	std::vector<Graph::vertexID> cachedPath;
+	unsigned cachedResult;
+	const uint64_t hash = table.enabled() ? stateHash(S, border) : 0;
+	if (level != topLevel && table.lookup(hash, level, cachedResult, cachedPath))
+	{
+		for (Graph::vertexID x : cachedPath)
+		{
+			currentPath.push_back(x);
+		}
+		
+		if (cachedResult > globalBestResult)
+		{
+			globalBestResult = cachedResult;
+			std::swap(globalBestPath, currentPath);
+		}
+		return;
+	}
+	
+	// Keep track of the vertices added, and whether they were taken from
+	// the border. A cached path may contain vertices that are not in this
+	// border, those must not be put back into it.
+	std::stack<std::pair<Graph::vertexID,bool>> added;
 	
 	indexedList<Graph::vertexID, Graph::numVertices> bestPath;
 	unsigned bestResult = 0;
@@ -92,6 +209,14 @@ void nested_monte_carlo(int id, Subtree& S,
 			break;
 		}
 		
+		// At level 0, each playout is added to a batch here and run
+		// together after the loop, if the graph is small enough.
+		constexpr bool batched = BitboardPlayouts::supported;
+		if (batched && level == 0)
+		{
+			batches[id].reset(S, (uint64_t(rand()) << 32) ^ rand());
+		}
+		
 		indexedList<Graph::vertexID, Graph::numVertices> trialPath;
 		do
 		{
@@ -112,12 +237,18 @@ void nested_monte_carlo(int id, Subtree& S,
 			
 			trialPath.push_back(x);
 			
-			if (level == 0)
+			if (batched && level == 0)
+				batches[id].addPlayout(x,border);
+			else if (level == 0)
 				randomBranch(id,S,border,bestResult,trialPath,bestPath);
 			else
 				nested_monte_carlo(id,S,border,previous_actions, level - 1,
 					bestResult,trialPath,bestPath);
 			
+			// Nothing is restored, the caller of the top level will
+			// throw away this state.
+			if (outOfTime) return;
+			
 			trialPath.pop_back();
 			
 			defs::restore(border,previous_actions);
@@ -126,20 +257,24 @@ void nested_monte_carlo(int id, Subtree& S,
 		}
 		while (!border.empty());
 		
+		if (batched && level == 0)
+		{
+			runBatch(id,S,bestResult,bestPath);
+			if (outOfTime) return;
+		}
+		
 		std::swap(border, defs::lists[id][S.numInduced]);
 		
 		Graph::vertexID nextVertex = bestPath.pop_front();
 		
 		S.add(nextVertex);
 		
-		added.push(nextVertex);
-		
-		border.remove(nextVertex);
+		added.emplace(nextVertex, border.remove(nextVertex));
 		
 		previous_actions.push({defs::stop,0});
 		defs::update(S,border,nextVertex,previous_actions);
 		
-		if (level == NMC_LEVEL)
+		if (level == topLevel && showDecisions)
 		{
 			std::cout << "Level " << level << " decided on vertex "
 				<< static_cast<uintmax_t>(nextVertex) << ", numInduced = "
@@ -154,17 +289,29 @@ void nested_monte_carlo(int id, Subtree& S,
 	Graph::vertexID temp = currentPath.pop_front();
 	while(!added.empty())
 	{
-		Graph::vertexID x = added.top();
+		auto [x, wasInBorder] = added.top();
 		added.pop();
 		
 		S.rem(x);
 		
 		defs::restore(border,previous_actions);
 		
-		border.push_back(x);
+		if (wasInBorder)
+			border.push_back(x);
 		
 		currentPath.push_front(x);
 	}
+	
+	if (table.enabled())
+	{
+		cachedPath.clear();
+		for (Graph::vertexID x : currentPath)
+		{
+			cachedPath.push_back(x);
+		}
+		table.store(hash, level, result, cachedPath);
+	}
+	
 	currentPath.push_front(temp);
 	
 	if (result > globalBestResult)
@@ -174,18 +321,12 @@ void nested_monte_carlo(int id, Subtree& S,
 	}
 }
 
-int main(int num_args, char** args)
+// Runs a nested Monte-Carlo search of a given level from vertex 0, returns
+// the size of the largest tree it found. If the search runs out of time,
+// returns the largest found before then.
+unsigned search(unsigned level)
 {
-	if (num_args != 2)
-	{
-		std::cerr << "usage: " << args[0] << " <outfile>" << std::endl;
-		exit(1);
-	}
-	
-	defs::outfile = args[1];
-	
-	srand(time(NULL));
-	defs::start_time = clock();
+	topLevel = level;
 	
 	unsigned globalBestResult = 0;
 	indexedList<Graph::vertexID, Graph::numVertices> currentPath;
@@ -200,34 +341,133 @@ int main(int num_args, char** args)
 	
 	defs::update(S,border,0,previous_actions);
 	
-	nested_monte_carlo(0,S,border,previous_actions,NMC_LEVEL,
+	nested_monte_carlo(0,S,border,previous_actions,level,
 		globalBestResult,currentPath,globalBestPath);
 	
-	std::cout << "Monte-Carlo result = " << globalBestResult << std::endl;
+	// A search that was stopped early can leave vertices in the
+	// temporary lists.
+	if (outOfTime)
+	{
+		for (auto& list : defs::lists[0])
+		{
+			list.clear();
+		}
+	}
 	
-	//pool.push(randomSample,0);
+	return globalBestResult;
+}
+
+// Runs searches of increasing level until the time budget expires. After
+// each search, the time the next level would take is estimated from the
+// number of playouts of the last two levels and the playout rate. If it
+// would not finish in time, the deepest level that did is restarted with a
+// new seed instead.
+void anytimeSearch(double seconds)
+{
+	const auto start = clock_type::now();
+	deadline = start + std::chrono::duration_cast<clock_type::duration>(
+		std::chrono::duration<double>(seconds));
+	
+	unsigned level = 0;
+	
+	// The deepest level that has finished, if any has.
+	std::optional<unsigned> deepest;
 	
-	// Wait for all threads to finish
-	/*
-	while (pool.n_idle() < NUM_THREADS)
+	// Number of playouts of the previous completed level, a level below
+	// 0 would have had one.
+	double previousPlayouts = 1;
+	
+	for (unsigned run = 0; !outOfTime; ++run)
 	{
-		std::this_thread::sleep_for (std::chrono::seconds(1));
+		srand(time(NULL) + run);
 		
-		unsigned long long total = 0;
-		for (unsigned i = 0; i < NUM_THREADS; i++) total += numLeaves[i];
+		const auto runStart = clock_type::now();
+		const uintmax_t leavesBefore = defs::numLeaves[0];
 		
-		std::lock_guard<std::mutex> lock(IOmutex);
+		// Only show progress within a level the first time it is run, and
+		// not for level 0, which decides too quickly for it to be useful.
+		showDecisions = level > 0 && (!deepest || *deepest < level);
 		
-		std::cout << "\r" << threadSeconds() << " thread-seconds elapsed, "
-			<< total << " leaves encountered";
+		const unsigned result = search(level);
 		
-		std::cout.flush();
+		const double playouts = defs::numLeaves[0] - leavesBefore;
+		const double elapsed = std::chrono::duration<double>(clock_type::now() - runStart).count();
 		
-		lastWasNew = false;
+		if (outOfTime)
+		{
+			std::cout << "Level " << level << " stopped after " << playouts
+				<< " playouts in " << elapsed << " seconds" << std::endl;
+			break;
+		}
+		
+		std::cout << "Level " << level << " finished: result = " << result << ", "
+			<< playouts << " playouts in " << elapsed << " seconds" << std::endl;
+		
+		deepest = level;
+		
+		// Each level makes about as many calls to the level below as the
+		// level below made to the one below it.
+		const double predicted = elapsed * (playouts / previousPlayouts);
+		const double remaining = std::chrono::duration<double>(deadline - clock_type::now()).count();
+		
+		if (predicted <= remaining)
+		{
+			++level;
+			previousPlayouts = playouts;
+		}
+		else
+		{
+			// The same state would give the same results at the
+			// lower levels, so clear them for the restart.
+			table.clear();
+		}
 	}
-	*/
 	
-	//std::clog << threadSeconds() << " thread-seconds" << std::endl;
+	std::cout << "Anytime search finished after "
+		<< std::chrono::duration<double>(clock_type::now() - start).count()
+		<< " seconds, deepest level completed = "
+		<< (deepest ? std::to_string(*deepest) : std::string("none")) << std::endl;
+}
+
+int main(int num_args, char** args)
+{
+	if (num_args < 2 || num_args > 5)
+	{
+		std::cerr << "usage: " << args[0]
+			<< " <outfile> [table size in MB] [local search seconds per new best]"
+			<< " [time budget in seconds]" << std::endl;
+		exit(1);
+	}
+	
+	defs::outfile = args[1];
+	
+	const std::size_t tableMB = (num_args >= 3) ? std::stoull(args[2]) : DEFAULT_TABLE_MB;
+	table.resize(tableMB << 20);
+	
+	if (num_args >= 4)
+	{
+		polish.seconds = std::stod(args[3]);
+	}
+	
+	const double budget = (num_args == 5) ? std::stod(args[4]) : 0;
+	
+	srand(time(NULL));
+	defs::start_time = clock();
+	
+	if (budget > 0)
+	{
+		anytimeSearch(budget);
+	}
+	else
+	{
+		std::cout << "Monte-Carlo result = " << search(NMC_LEVEL) << std::endl;
+	}
+	
+	if (table.enabled())
+	{
+		std::cout << "Transposition table: capacity " << table.capacity() << " entries, "
+			<< table.numHits() << " hits, " << table.numMisses() << " misses" << std::endl;
+	}
 	
 	std::clog << "Largest size (no enclosed space) = " << defs::largestTree << std::endl;
 }
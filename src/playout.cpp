@@ -0,0 +1,246 @@
+#include "playout.hpp"
+
+#include <bit>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	// Advances a SplitMix64 generator and returns its next output.
+	uint64_t nextRandom(uint64_t& state)
+	{
+		uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// Returns the position of the nth set bit of w, which must exist.
+	unsigned selectBit(uint64_t w, unsigned n)
+	{
+#ifdef __BMI2__
+		return std::countr_zero(_pdep_u64(uint64_t{1} << n, w));
+#else
+		for (; n > 0; --n)
+		{
+			w &= w - 1;
+		}
+		return std::countr_zero(w);
+#endif
+	}
+
+	template<std::size_t N>
+	bool test(const std::array<uint64_t, N>& b, Graph::vertexID x)
+	{
+		return (b[x / 64] >> (x % 64)) & 1;
+	}
+
+	template<std::size_t N>
+	bool isEmpty(const std::array<uint64_t, N>& b)
+	{
+		for (uint64_t w : b)
+		{
+			if (w != 0) return false;
+		}
+		return true;
+	}
+
+	template<std::size_t N>
+	void set(std::array<uint64_t, N>& b, Graph::vertexID x)
+	{
+		b[x / 64] |= uint64_t{1} << (x % 64);
+	}
+}
+
+void simpleUpdate(Subtree& S,
+	indexedList<Graph::vertexID, Graph::numVertices>& border, Graph::vertexID x)
+{
+	for (Graph::vertexID y : Graph::vertices[x].neighbors)
+	{
+		if (S.cnt(y) > 1)
+		{
+			border.remove(y);
+		}
+		else if (y > S.root && !S.has(y))
+		{
+			border.push_front(y);
+		}
+	}
+}
+
+void randomPlayout(Subtree& S, indexedList<Graph::vertexID, Graph::numVertices>& border,
+	indexedList<Graph::vertexID, Graph::numVertices>& path)
+{
+	while(!border.empty())
+	{
+		Graph::vertexID x;
+		do
+		{
+			// Get and remove a random element,
+			// ensure it is valid.
+			x = border.removeRandom();
+		}
+		while (!S.safeToAdd(x) && !border.empty());
+
+		// Check for this, not the empty border.
+		if (!S.add(x)) break;
+
+		simpleUpdate(S,border,x);
+
+		path.push_back(x);
+	}
+}
+
+const std::vector<BitboardPlayouts::bitboard> BitboardPlayouts::neighborhoods = []
+{
+	std::vector<bitboard> result;
+	if (!supported) return result;
+
+	result.resize(Graph::numVertices);
+	for (Graph::vertexID x = 0; x < Graph::numVertices; ++x)
+	{
+		result[x].fill(0);
+		for (Graph::vertexID y : Graph::vertices[x].neighbors)
+		{
+			set(result[x], y);
+		}
+	}
+	return result;
+}();
+
+void BitboardPlayouts::reset(const Subtree& S, uint64_t seed_)
+{
+	seed = seed_;
+	usedPlayouts = 0;
+
+	baseInduced.fill(0);
+	baseAdjacent.fill(0);
+	baseCrowded.fill(0);
+	aboveRoot.fill(0);
+	baseNumInduced = S.numInduced;
+
+	for (Graph::vertexID x = 0; x < Graph::numVertices; ++x)
+	{
+		if (S.has(x)) set(baseInduced, x);
+		if (S.cnt(x) >= 1) set(baseAdjacent, x);
+		if (S.cnt(x) >= 2) set(baseCrowded, x);
+		if (x > S.root) set(aboveRoot, x);
+	}
+}
+
+void BitboardPlayouts::addPlayout(Graph::vertexID x,
+	indexedList<Graph::vertexID, Graph::numVertices>& border)
+{
+	if (usedPlayouts == playouts.size())
+	{
+		playouts.emplace_back();
+	}
+	playout& t = playouts[usedPlayouts++];
+
+	t.induced = baseInduced;
+	t.adjacent = baseAdjacent;
+	t.crowded = baseCrowded;
+	t.numInduced = baseNumInduced;
+	t.rng = seed ^ (0xD1B54A32D192ED03ull * usedPlayouts);
+
+	t.path.clear();
+	t.border.fill(0);
+	add(t, x);
+
+	// The border after adding x is already known.
+	t.border.fill(0);
+	for (Graph::vertexID y : border)
+	{
+		set(t.border, y);
+	}
+}
+
+void BitboardPlayouts::add(playout& t, Graph::vertexID x) const
+{
+	const bitboard& n = neighborhoods[x];
+
+	set(t.induced, x);
+	++t.numInduced;
+	t.path.push_back(x);
+
+	// Neighbors of x that had one induced neighbor now have two, and those
+	// leave the border. Those that had none now have one, and join it.
+	for (unsigned w = 0; w < WORDS; ++w)
+	{
+		t.crowded[w] |= t.adjacent[w] & n[w];
+		t.adjacent[w] |= n[w];
+		t.border[w] = (t.border[w] & ~(n[w] & t.crowded[w]))
+			| (n[w] & ~t.crowded[w] & ~t.induced[w] & aboveRoot[w]);
+	}
+}
+
+bool BitboardPlayouts::safeToAdd(const playout& t, Graph::vertexID x) const
+{
+	// Only the first induced neighbor is checked, as in Subtree::safeToAdd.
+	for (const Graph::vertexID p : Graph::vertices[x].neighbors)
+	{
+		if (!test(t.induced, p)) continue;
+
+		const auto exists = [&t, x](Graph::vertexID y)
+			{ return y != Graph::EMPTY && (y == x || test(t.induced, y)); };
+
+		const auto& dirs = Graph::vertices[p].directions;
+
+		unsigned count = 0;
+		for (Graph::vertexID y : dirs)
+		{
+			count += exists(y);
+		}
+
+		if (count != 4) return count < 4;
+
+		// Ensure all axis have at least one neighbor
+		for (unsigned d = 0; d < dirs.size() / 2; ++d)
+		{
+			if (!exists(dirs[d]) && !exists(dirs[dirs.size() - 1 - d]))
+				return false;
+		}
+		return true;
+	}
+	return false;
+}
+
+Graph::vertexID BitboardPlayouts::removeRandom(playout& t) const
+{
+	unsigned count = 0;
+	for (uint64_t w : t.border)
+	{
+		count += std::popcount(w);
+	}
+
+	unsigned n = nextRandom(t.rng) % count;
+	for (unsigned w = 0; ; ++w)
+	{
+		const unsigned inWord = std::popcount(t.border[w]);
+		if (n < inWord)
+		{
+			const unsigned bit = selectBit(t.border[w], n);
+			t.border[w] &= ~(uint64_t{1} << bit);
+			return static_cast<Graph::vertexID>(w * 64 + bit);
+		}
+		n -= inWord;
+	}
+}
+
+void BitboardPlayouts::run()
+{
+	for (unsigned i = 0; i < usedPlayouts; ++i)
+	{
+		playout& t = playouts[i];
+		while (!isEmpty(t.border))
+		{
+			const Graph::vertexID x = removeRandom(t);
+			if (safeToAdd(t, x))
+			{
+				add(t, x);
+			}
+		}
+	}
+}
@@ -0,0 +1,107 @@
+#ifndef PLAYOUT_HPP
+#define PLAYOUT_HPP
+
+#include "graph.hpp"
+#include "subTree.hpp"
+#include "indexedList.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Updates the border of S after adding x, does not track changes.
+void simpleUpdate(Subtree& S,
+	indexedList<Graph::vertexID, Graph::numVertices>& border, Graph::vertexID x);
+
+// Randomly adds vertices from the border to S until it becomes maximal.
+// Each vertex added is appended to path.
+void randomPlayout(Subtree& S, indexedList<Graph::vertexID, Graph::numVertices>& border,
+	indexedList<Graph::vertexID, Graph::numVertices>& path);
+
+/*
+BitboardPlayouts runs a set of random playouts one after another, with each
+tree stored as bitboards (one bit per vertex) of its induced vertices, the
+vertices with at least one and at least two induced neighbors, and its border.
+Adding a vertex updates all of these with a few word-wide operations on the
+neighborhood of that vertex, instead of a loop over its neighbors, and
+choosing a random border vertex is a popcount and a bit select instead of a
+walk along a list.
+
+The playouts make the same choices with the same probabilities as
+randomPlayout: a random border vertex is removed, and added if it keeps the
+neighbor condition, until the border is empty.
+
+Every playout in a set starts from the same tree with one more vertex, as
+at level 0 of a nested Monte-Carlo search, so the tree is only converted to
+bitboards once per set. This is only worthwhile for small graphs, larger
+graphs should use randomPlayout.
+*/
+
+class BitboardPlayouts
+{
+	public:
+
+	constexpr static unsigned WORDS = (Graph::numVertices + 63) / 64;
+
+	constexpr static bool supported = Graph::numVertices <= 512;
+
+	using bitboard = std::array<uint64_t, WORDS>;
+
+	// Starts a new set of playouts from S, discarding any previous ones.
+	// Random choices are seeded from seed.
+	void reset(const Subtree& S, uint64_t seed);
+
+	// Adds a playout starting from the tree given to reset with x added,
+	// with the given border (after adding x).
+	void addPlayout(Graph::vertexID x, indexedList<Graph::vertexID, Graph::numVertices>& border);
+
+	// Runs each playout in turn until it cannot grow.
+	void run();
+
+	[[nodiscard]] unsigned numPlayouts() const { return usedPlayouts; }
+
+	// The size of the tree a playout ended with.
+	[[nodiscard]] unsigned result(unsigned i) const { return playouts[i].numInduced; }
+
+	// The vertices added by a playout, starting with the one given to addPlayout.
+	[[nodiscard]] const std::vector<Graph::vertexID>& path(unsigned i) const
+		{ return playouts[i].path; }
+
+	private:
+
+	struct playout
+	{
+		bitboard induced, adjacent, crowded, border;
+		unsigned numInduced;
+		uint64_t rng;
+		std::vector<Graph::vertexID> path;
+	};
+
+	// Adds x to a playout, assumes it keeps the neighbor condition.
+	void add(playout& p, Graph::vertexID x) const;
+
+	// Returns true iff adding x to a playout keeps the neighbor condition.
+	[[nodiscard]] bool safeToAdd(const playout& p, Graph::vertexID x) const;
+
+	// Removes a random vertex from the border of a playout and returns it.
+	// Assumes the border is not empty.
+	[[nodiscard]] Graph::vertexID removeRandom(playout& p) const;
+
+	// The state of the tree given to reset.
+	bitboard baseInduced, baseAdjacent, baseCrowded;
+	unsigned baseNumInduced;
+
+	// Vertices greater than the root, only these can be on the border.
+	bitboard aboveRoot;
+
+	uint64_t seed;
+
+	// Playouts are kept between sets to reuse their paths.
+	std::vector<playout> playouts;
+	unsigned usedPlayouts = 0;
+
+	// The neighborhood of each vertex, as a bitboard.
+	static const std::vector<bitboard> neighborhoods;
+};
+
+#endif
@@ -0,0 +1,124 @@
+#include "defs.hpp"
+#include "graph.hpp"
+#include "subTree.hpp"
+#include "indexedList.hpp"
+#include "playout.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <stack>
+
+// Compares the number of random playouts per second of randomPlayout and
+// BitboardPlayouts. Both run the same playouts, each starting from vertex 0 with
+// one of its border vertices added, as at level 0 of a nested Monte-Carlo
+// search.
+
+using clock_type = std::chrono::steady_clock;
+
+// Number of playouts given to BitboardPlayouts at a time.
+constexpr unsigned BATCH_SIZE = 64;
+
+struct benchmarkResult
+{
+	uintmax_t playouts = 0;
+	uintmax_t totalSize = 0;
+	double seconds = 0;
+};
+
+void print(const std::string& name, const benchmarkResult& r)
+{
+	std::cout << name << ": " << r.playouts / r.seconds << " playouts per second, mean size "
+		<< static_cast<double>(r.totalSize) / r.playouts << std::endl;
+}
+
+int main(int num_args, char** args)
+{
+	if (num_args > 2)
+	{
+		std::cerr << "usage: " << args[0] << " [seconds per method]" << std::endl;
+		exit(1);
+	}
+
+	const double seconds = (num_args == 2) ? std::stod(args[1]) : 5;
+	const auto duration = std::chrono::duration_cast<clock_type::duration>(
+		std::chrono::duration<double>(seconds));
+
+	srand(time(NULL));
+
+	Subtree S(0);
+	indexedList<Graph::vertexID, Graph::numVertices> border;
+	std::stack<defs::action> previous_actions;
+	defs::update(S,border,0,previous_actions);
+
+	// The state after adding each border vertex, which every playout
+	// starts from.
+	std::vector<Graph::vertexID> firsts;
+	std::vector<Subtree> starts;
+	std::vector<indexedList<Graph::vertexID, Graph::numVertices>> startBorders;
+	for (Graph::vertexID x : border)
+	{
+		Subtree T = S;
+		T.add(x);
+		indexedList<Graph::vertexID, Graph::numVertices> b = border;
+		b.remove(x);
+		simpleUpdate(T,b,x);
+
+		firsts.push_back(x);
+		starts.push_back(T);
+		startBorders.push_back(b);
+	}
+
+	benchmarkResult scalar;
+	{
+		const auto start = clock_type::now();
+		while (clock_type::now() - start < duration)
+		{
+			for (unsigned i = 0; i < BATCH_SIZE; ++i)
+			{
+				const unsigned k = i % firsts.size();
+				Subtree T = starts[k];
+				indexedList<Graph::vertexID, Graph::numVertices> b = startBorders[k];
+				indexedList<Graph::vertexID, Graph::numVertices> path;
+				randomPlayout(T,b,path);
+
+				++scalar.playouts;
+				scalar.totalSize += T.numInduced;
+			}
+		}
+		scalar.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+	}
+	print("Scalar", scalar);
+
+	if constexpr (!BitboardPlayouts::supported)
+	{
+		std::cout << "Bitboard playouts need at most 512 vertices" << std::endl;
+		return 0;
+	}
+
+	benchmarkResult bitboard;
+	{
+		BitboardPlayouts batch;
+		const auto start = clock_type::now();
+		while (clock_type::now() - start < duration)
+		{
+			batch.reset(S, (uint64_t(rand()) << 32) ^ rand());
+			for (unsigned i = 0; i < BATCH_SIZE; ++i)
+			{
+				const unsigned k = i % firsts.size();
+				batch.addPlayout(firsts[k],startBorders[k]);
+			}
+			batch.run();
+
+			for (unsigned i = 0; i < batch.numPlayouts(); ++i)
+			{
+				++bitboard.playouts;
+				bitboard.totalSize += batch.result(i);
+			}
+		}
+		bitboard.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+	}
+	print("Bitboard", bitboard);
+
+	std::cout << "Speedup: " << (bitboard.playouts / bitboard.seconds) / (scalar.playouts / scalar.seconds)
+		<< std::endl;
+}
@@ -1,13 +1,27 @@
 #include "graph.hpp"
 #include "subTree.hpp"
 
+#include <cstdio>
 #include <fstream>
 #include <queue>
+#include <random>
 
 // These are used to print to the file
 #define BLOCK_PRESENT 'X'
 #define BLOCK_MISSING '_'
 
+const std::array<uint64_t, Graph::numVertices> Subtree::zobristKeys = []
+{
+	std::mt19937_64 generator(0x9E3779B97F4A7C15ull);
+	
+	std::array<uint64_t, Graph::numVertices> keys;
+	for (uint64_t& key : keys)
+	{
+		key = generator();
+	}
+	return keys;
+}();
+
 bool Subtree::add(Graph::vertexID i)
 {
 	vertices[i].induced = true;
@@ -31,6 +45,7 @@ bool Subtree::add(Graph::vertexID i)
 	}
 	
 	++numInduced;
+	hash ^= zobristKeys[i];
 
 	for (const Graph::vertexID x : Graph::vertices[i].neighbors)
 	{
@@ -46,6 +61,7 @@ void Subtree::rem(Graph::vertexID i)
 	vertices[i].induced = false;
 	
 	--numInduced;
+	hash ^= zobristKeys[i];
 	
 	for (const Graph::vertexID x : Graph::vertices[i].neighbors)
 	{
@@ -53,6 +69,19 @@ void Subtree::rem(Graph::vertexID i)
 	}
 }
 
+void Subtree::join(Graph::vertexID i)
+{
+	vertices[i].induced = true;
+	
+	++numInduced;
+	hash ^= zobristKeys[i];
+	
+	for (const Graph::vertexID x : Graph::vertices[i].neighbors)
+	{
+		++vertices[x].effectiveDegree;
+	}
+}
+
 void Subtree::print() const
 {
 	std::cout << "Subgraph: ";
@@ -65,7 +94,10 @@ void Subtree::print() const
 
 void Subtree::writeToFile(std::string filename) const
 {
-	std::ofstream file(filename);
+	// Write to a temporary file and rename it over the old one, so the
+	// file always holds a complete result even if the program is killed.
+	const std::string tempname = filename + ".tmp";
+	std::ofstream file(tempname);
 	
 	for (unsigned d : dim_array)
 	{
@@ -114,9 +146,12 @@ void Subtree::writeToFile(std::string filename) const
 	}
 	
 	file << numInduced << std::endl;
+	
+	file.close();
+	std::rename(tempname.c_str(), filename.c_str());
 }
 
-Subtree::Subtree(Graph::vertexID r) : numInduced(0), root(r), vertices()
+Subtree::Subtree(Graph::vertexID r) : numInduced(0), root(r), hash(0), vertices()
 {
 	add(r);
 }
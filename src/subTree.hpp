@@ -5,6 +5,7 @@
 
 #include <array>
 #include <vector>
+#include <cstdint>
 #include <iostream>
 
 // Represents an induced subtree
@@ -32,8 +33,17 @@ struct Subtree
 	
 	Graph::vertexID root;
 	
+	// Zobrist hash of the set of induced vertices, maintained by add and rem.
+	// Two subtrees with the same vertices have the same hash, regardless of
+	// the order they were added in.
+	uint64_t hash;
+	
 	std::array<subTreeVertex, Graph::numVertices> vertices;
 	
+	// One random key per vertex, the hash is the XOR of the keys of all
+	// induced vertices. Seeded with a constant so hashes are reproducible.
+	static const std::array<uint64_t, Graph::numVertices> zobristKeys;
+	
 	Subtree(Graph::vertexID);
 	
 	unsigned cnt(Graph::vertexID i) const { return vertices[i].effectiveDegree; }
@@ -44,6 +54,11 @@ struct Subtree
 	
 	void rem(Graph::vertexID);
 	
+	// Adds i without validating, and updates the degree of every neighbor.
+	// Unlike add, i may have more than one induced neighbor, in which case
+	// the result has a cycle until one of its vertices is removed.
+	void join(Graph::vertexID);
+	
 	bool exists(Graph::vertexID i) const
 		{ return i != Graph::EMPTY && vertices[i].induced; }
 	
@@ -0,0 +1,320 @@
+#include "defs.hpp"
+#include "graph.hpp"
+#include "subTree.hpp"
+#include "localSearch.hpp"
+#include "cubicLattice.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+Builds an induced tree of the compiled in size from a tile found by
+optimal_tile, giving a lower bound for sizes far too large to search.
+
+The tile is repeated along the first dimension. Across the others, copies of
+its cross-section are mirrored, so that copies meet along identical faces.
+The result is a dense induced forest, but copies touch at the seams and the
+tile is only a forest, not a tree. So it is turned into a tree by adding its
+vertices in breadth-first order, skipping any that would close a cycle, and
+adding a vertex outside of it wherever that joins another part of it. Copies
+also close off pockets of empty cells, so leaves are removed until every
+empty cell can be reached from the outside. A local search then repairs what
+it can around the seams, and the best result without enclosed space is
+checked again from scratch with the same checks as the analyzer.
+
+optimal_tile prints each slice in the symmetry that follows the slice before
+it, and repeats a tile until its first slice follows its last, so copies along
+the first dimension fit together and only the mirrored seams need repair.
+*/
+
+namespace
+{
+	constexpr auto dims = std::to_array<unsigned>({ SIZE });
+
+	struct tile
+	{
+		// The dimensions of the cross-section.
+		std::vector<unsigned> dims;
+
+		// Each slice, one character per cell, with the last
+		// dimension of the cross-section changing fastest.
+		std::vector<std::string> slices;
+	};
+
+	// Reads a tile as optimal_tile prints it, a line that starts with the
+	// dimensions of its cross-section, such as "3,4: 23/36 ...", then each
+	// slice. optimal_tile takes dimensions with the first changing fastest,
+	// the opposite of SIZE, so they are reversed here. Only the first tile in
+	// the file is read.
+	bool readTile(const std::string& filename, tile& t)
+	{
+		std::ifstream file(filename);
+
+		std::string line;
+		if (!std::getline(file, line)) return false;
+
+		const std::size_t colon = line.find(':');
+		if (colon == std::string::npos) return false;
+
+		std::istringstream dimStream(line.substr(0, colon));
+		for (unsigned d; dimStream >> d; dimStream.ignore(1, ','))
+		{
+			t.dims.insert(t.dims.begin(), d);
+		}
+
+		unsigned numCells = 1;
+		for (unsigned d : t.dims)
+		{
+			numCells *= d;
+		}
+
+		// The next tile, if optimal_tile was given more than one size,
+		// starts with another line like the first.
+		while (std::getline(file, line) && line.find(':') == std::string::npos)
+		{
+			if (line.size() == numCells &&
+				line.find_first_not_of("X_") == std::string::npos)
+			{
+				t.slices.push_back(line);
+			}
+		}
+
+		return t.dims.size() + 1 == dims.size() && !t.slices.empty();
+	}
+
+	// Returns the coordinate in a copy of length n that c is at, with every
+	// other copy mirrored.
+	unsigned mirror(unsigned c, unsigned n)
+	{
+		c %= 2 * n;
+		return (c < n) ? c : 2 * n - 1 - c;
+	}
+
+	// Returns true iff the tile has an induced vertex at x.
+	bool inTile(const tile& t, Graph::vertexID x)
+	{
+		// The first dimension changes fastest in vertex IDs.
+		const unsigned slice = (x % dims[0]) % t.slices.size();
+		x /= dims[0];
+
+		unsigned cell = 0;
+		for (unsigned d = 0; d < t.dims.size(); ++d)
+		{
+			cell = cell * t.dims[d] + mirror(x % dims[d + 1], t.dims[d]);
+			x /= dims[d + 1];
+		}
+
+		return t.slices[slice][cell] == INDUCED_VERTEX;
+	}
+
+	// Adds x to S if it has exactly one induced neighbor and the neighbor
+	// condition still holds, returns true iff it was added.
+	bool addLeaf(Subtree& S, Graph::vertexID x)
+	{
+		return !S.has(x) && S.cnt(x) == 1 && S.add(x);
+	}
+
+	// Grows a tree through as many of the wanted vertices as possible.
+	Subtree buildTree(const std::vector<bool>& wanted)
+	{
+		Graph::vertexID root = 0;
+		while (root < Graph::numVertices && !wanted[root]) ++root;
+
+		Subtree S(root);
+
+		std::vector<Graph::vertexID> toVisit { root };
+		while (true)
+		{
+			// Add every wanted vertex that can be reached
+			while (!toVisit.empty())
+			{
+				const Graph::vertexID x = toVisit.back();
+				toVisit.pop_back();
+
+				for (Graph::vertexID y : Graph::vertices[x].neighbors)
+				{
+					if (wanted[y] && addLeaf(S, y))
+					{
+						toVisit.push_back(y);
+					}
+				}
+			}
+
+			// Then join another part of the tile with a vertex outside it,
+			// one that would leave a wanted vertex as a leaf.
+			for (Graph::vertexID x = 0; x < Graph::numVertices && toVisit.empty(); ++x)
+			{
+				if (wanted[x] || S.has(x) || S.cnt(x) != 1 || !S.safeToAdd(x)) continue;
+
+				for (Graph::vertexID y : Graph::vertices[x].neighbors)
+				{
+					if (wanted[y] && !S.has(y) && S.cnt(y) == 0)
+					{
+						S.add(x);
+						if (addLeaf(S, y))
+						{
+							toVisit.push_back(y);
+						}
+						else
+						{
+							S.rem(x);
+						}
+						break;
+					}
+				}
+			}
+
+			if (toVisit.empty()) return S;
+		}
+	}
+
+	// Removes leaves of S until it has no enclosed space, preferring those
+	// next to both an enclosed vertex and one that can be reached from the
+	// outside. Returns false if some enclosed space has no leaf next to it.
+	bool openEnclosedSpace(Subtree& S)
+	{
+		while (true)
+		{
+			// Mark the empty vertices that can be reached from the outer shell.
+			std::vector<bool> outside(Graph::numVertices);
+			std::vector<Graph::vertexID> toVisit;
+			for (Graph::vertexID x = 0; x < Graph::numVertices; ++x)
+			{
+				if (!S.has(x) && Graph::onOuterShell(x))
+				{
+					outside[x] = true;
+					toVisit.push_back(x);
+				}
+			}
+			while (!toVisit.empty())
+			{
+				const Graph::vertexID x = toVisit.back();
+				toVisit.pop_back();
+
+				for (Graph::vertexID y : Graph::vertices[x].neighbors)
+				{
+					if (!S.has(y) && !outside[y])
+					{
+						outside[y] = true;
+						toVisit.push_back(y);
+					}
+				}
+			}
+
+			bool enclosed = false, opens = false;
+			Graph::vertexID leaf = Graph::EMPTY;
+			for (Graph::vertexID x = 0; x < Graph::numVertices && !opens; ++x)
+			{
+				if (S.has(x) || outside[x]) continue;
+				enclosed = true;
+
+				for (Graph::vertexID v : Graph::vertices[x].neighbors)
+				{
+					if (!S.has(v) || S.cnt(v) != 1) continue;
+
+					if (leaf == Graph::EMPTY) leaf = v;
+
+					for (Graph::vertexID w : Graph::vertices[v].neighbors)
+					{
+						if (outside[w])
+						{
+							leaf = v;
+							opens = true;
+						}
+					}
+					if (opens) break;
+				}
+			}
+
+			if (!enclosed) return true;
+			if (leaf == Graph::EMPTY) return false;
+
+			S.rem(leaf);
+		}
+	}
+}
+
+// Reads a tile, lays it out over the compiled in size and turns it into a
+// tree, runs a local search on that with every thread for the given number
+// of seconds, then writes the result to the output file.
+int main(int num_args, char** args)
+{
+	if (num_args != 3 && num_args != 4)
+	{
+		std::cerr << "usage: " << args[0] << " <tile file> <outfile> [seconds]" << std::endl;
+		exit(1);
+	}
+
+	tile t;
+	if (!readTile(args[1], t))
+	{
+		std::cerr << "could not read a tile with a cross-section of "
+			<< dims.size() - 1 << " dimensions from " << args[1] << std::endl;
+		exit(1);
+	}
+
+	defs::outfile = args[2];
+	defs::start_time = clock();
+
+	std::vector<bool> wanted(Graph::numVertices);
+	unsigned numWanted = 0;
+	for (Graph::vertexID x = 0; x < Graph::numVertices; ++x)
+	{
+		wanted[x] = inTile(t, x);
+		numWanted += wanted[x];
+	}
+
+	if (numWanted == 0)
+	{
+		std::cerr << "the tile has no induced vertices" << std::endl;
+		exit(1);
+	}
+
+	Subtree start = buildTree(wanted);
+	std::cout << "Laid out " << numWanted << " vertices of the tile, "
+		<< "and made a tree of " << start.numInduced << std::endl;
+
+	if (!openEnclosedSpace(start))
+	{
+		std::cerr << "could not open the enclosed space of the tree" << std::endl;
+		exit(1);
+	}
+	std::cout << start.numInduced << " after opening enclosed space" << std::endl;
+
+	defs::checkCandidate(start);
+
+	localSearch::options opts;
+	opts.numThreads = defs::NUM_THREADS;
+	opts.seed = time(NULL);
+	if (num_args == 4)
+	{
+		opts.seconds = std::stod(args[3]);
+	}
+
+	const Subtree best = localSearch::improve(start, opts);
+
+	std::cout << "Local search result = " << best.numInduced << std::endl;
+
+	// Check what was written without relying on Subtree.
+	std::vector<Graph::vertexID> vertices;
+	if (!localSearch::readFromFile(defs::outfile, vertices))
+	{
+		std::cerr << "no tree without enclosed space was found" << std::endl;
+		return 1;
+	}
+
+	CubicLattice lattice(std::vector<unsigned>(dims.begin(), dims.end()));
+	for (Graph::vertexID x : vertices)
+	{
+		lattice.add(x);
+	}
+
+	if (!printChecks(lattice, std::cout))
+	{
+		std::cerr << "the result failed a check" << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,93 @@
+#include "transpositionTable.hpp"
+
+void TranspositionTable::resize(std::size_t maxBytes)
+{
+	// Paths are reserved at their largest possible size when they are
+	// first stored, so this is an exact bound on the memory used.
+	constexpr std::size_t bytesPerBucket =
+		sizeof(bucket) + WAYS * Graph::numVertices * sizeof(Graph::vertexID);
+
+	buckets = std::vector<bucket>(maxBytes / bytesPerBucket);
+
+	clock = hits = misses = 0;
+}
+
+void TranspositionTable::clear()
+{
+	for (bucket& b : buckets)
+	{
+		for (entry& e : b)
+		{
+			e.levelPlusOne = 0;
+		}
+	}
+}
+
+bool TranspositionTable::lookup(uint64_t hash, unsigned level, unsigned& result,
+	std::vector<Graph::vertexID>& path)
+{
+	if (!enabled()) return false;
+
+	std::lock_guard<std::mutex> lock(lockOf(hash));
+
+	for (entry& e : bucketOf(hash))
+	{
+		if (e.levelPlusOne == level + 1 && e.hash == hash)
+		{
+			e.lastUsed = ++clock;
+
+			result = e.result;
+			path = e.path;
+
+			++hits;
+			return true;
+		}
+	}
+
+	++misses;
+	return false;
+}
+
+void TranspositionTable::store(uint64_t hash, unsigned level, unsigned result,
+	const std::vector<Graph::vertexID>& path)
+{
+	if (!enabled()) return;
+
+	std::lock_guard<std::mutex> lock(lockOf(hash));
+
+	bucket& b = bucketOf(hash);
+
+	// Find either the same state, or the entry to evict.
+	entry* victim = &b[0];
+	for (entry& e : b)
+	{
+		if (e.levelPlusOne == level + 1 && e.hash == hash)
+		{
+			// Already stored, only replace it if this result is better.
+			if (result <= e.result) return;
+
+			victim = &e;
+			break;
+		}
+
+		// Empty entries have levelPlusOne == 0, so they are always
+		// evicted first.
+		if (e.levelPlusOne < victim->levelPlusOne ||
+			(e.levelPlusOne == victim->levelPlusOne && e.lastUsed < victim->lastUsed))
+		{
+			victim = &e;
+		}
+	}
+
+	// Never evict a more expensive search to make room for a cheaper one.
+	if (victim->levelPlusOne > level + 1) return;
+
+	victim->hash = hash;
+	victim->levelPlusOne = level + 1;
+	victim->result = result;
+	victim->lastUsed = ++clock;
+
+	// Reserve the maximum size, so that reusing this entry never reallocates.
+	victim->path.reserve(Graph::numVertices);
+	victim->path.assign(path.begin(), path.end());
+}
@@ -0,0 +1,98 @@
+#ifndef TRANSPOSITION_TABLE_HPP
+#define TRANSPOSITION_TABLE_HPP
+
+#include "graph.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/*
+A transposition table caches the results of nested Monte-Carlo searches,
+keyed by a hash of the search state and the nesting level. The same state
+can be reached through many different orderings, with this the search from
+a state is only run once per level.
+
+The table is a fixed number of 4-way buckets, sized so that the table
+never exceeds a given number of bytes, even if every stored path is as
+long as possible. When a bucket is full, the entry with the lowest level
+is evicted (lower levels are cheaper to recompute), with ties broken by
+evicting the least recently used entry. Entries are never evicted to
+make room for an entry with a lower level.
+
+Lookups and stores are thread safe, buckets are protected by a fixed set
+of striped locks.
+*/
+
+class TranspositionTable
+{
+	public:
+
+	// Constructs an empty table that can store no entries.
+	TranspositionTable() {}
+
+	// Clears the table and resizes it to use at most maxBytes of memory.
+	// A size of 0 disables the table.
+	void resize(std::size_t maxBytes);
+
+	// Removes every entry, without changing the size of the table.
+	void clear();
+
+	// If the result of a search of the given level from the state with
+	// the given hash is stored, copies the size of the best tree found
+	// into result and the vertices that were added into path, and returns
+	// true. Otherwise, returns false.
+	bool lookup(uint64_t hash, unsigned level, unsigned& result,
+		std::vector<Graph::vertexID>& path);
+
+	// Stores the result of a search. If the state is already stored at
+	// this level, keeps whichever result is larger.
+	void store(uint64_t hash, unsigned level, unsigned result,
+		const std::vector<Graph::vertexID>& path);
+
+	[[nodiscard]] bool enabled() const { return !buckets.empty(); }
+
+	// The number of entries the table can hold, not how many it holds.
+	[[nodiscard]] std::size_t capacity() const { return buckets.size() * WAYS; }
+
+	[[nodiscard]] uintmax_t numHits  () const { return hits;   }
+	[[nodiscard]] uintmax_t numMisses() const { return misses; }
+
+	private:
+
+	constexpr static unsigned WAYS = 4;
+	constexpr static unsigned NUM_LOCKS = 64;
+
+	struct entry
+	{
+		uint64_t hash;
+
+		// Level 0 is a valid level, so the empty marker is stored
+		// as one more than the level.
+		unsigned levelPlusOne = 0;
+		unsigned result;
+
+		// Value of the table's clock when this entry was last used.
+		uint64_t lastUsed;
+
+		std::vector<Graph::vertexID> path;
+	};
+
+	using bucket = std::array<entry, WAYS>;
+
+	bucket& bucketOf(uint64_t hash)
+		{ return buckets[hash % buckets.size()]; }
+
+	std::mutex& lockOf(uint64_t hash)
+		{ return locks[(hash % buckets.size()) % NUM_LOCKS]; }
+
+	std::vector<bucket> buckets;
+	std::array<std::mutex, NUM_LOCKS> locks;
+
+	std::atomic<uint64_t> clock {0};
+	std::atomic<uintmax_t> hits {0}, misses {0};
+};
+
+#endif
@@ -0,0 +1,144 @@
+#include "beam_search.hpp"
+#include "reference_enumerator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Finds the size of the largest subtree of a graph without enclosed
+ * space by brute force.
+ * @param graph The graph to search
+ * @return The number of induced vertices in the largest such subtree
+ */
+vertex_id largest_subtree_size(const graph_type &graph) {
+  vertex_id largest = 0;
+  for (const auto &sub : testing::brute_force_enumerate(graph)) {
+    if (sub.n_induced() > largest && !has_enclosed_space(graph, sub)) {
+      largest = sub.n_induced();
+    }
+  }
+  return largest;
+}
+
+/**
+ * @brief Runs a beam search wide enough to keep every partial tree, and checks
+ * that it finds a subtree as large as the brute force search.
+ * @param dims The dimensions of the graph
+ */
+void check_beam_search_is_exact(const std::span<const std::size_t> dims) {
+  const graph_type graph{dims};
+  const auto outfile =
+      (std::filesystem::temp_directory_path() / "hrp_beam_search_test")
+          .string();
+  candidate_sink sink{graph, outfile};
+
+  const auto best =
+      beam_search(graph, beam_search_options{.width = 1 << 16}, sink);
+
+  CHECK(!has_enclosed_space(graph, best));
+  CHECK(best.n_induced() == largest_subtree_size(graph));
+  CHECK(sink.largest() == best.n_induced());
+
+  std::filesystem::remove(outfile);
+  std::filesystem::remove(outfile + "_enclosed");
+}
+
+TEST_CASE("Beam search") {
+  SECTION("Dims = {3, 3}") {
+    const std::vector<std::size_t> dims{3, 3};
+    check_beam_search_is_exact(dims);
+  }
+
+  SECTION("Dims = {2, 2, 3}") {
+    const std::vector<std::size_t> dims{2, 2, 3};
+    check_beam_search_is_exact(dims);
+  }
+
+  // Large enough for trees to enclose space, which are never the result.
+  SECTION("Dims = {3, 3, 3}") {
+    const std::vector<std::size_t> dims{3, 3, 3};
+    check_beam_search_is_exact(dims);
+  }
+
+  SECTION("Playouts are reproducible") {
+    const std::vector<std::size_t> dims{3, 4};
+    const graph_type graph{dims};
+    const auto outfile =
+        (std::filesystem::temp_directory_path() / "hrp_beam_search_test")
+            .string();
+
+    const beam_search_options options{
+        .width = 4, .n_playouts = 3, .seed = 7, .n_threads = 4};
+
+    candidate_sink sink_a{graph, outfile};
+    const auto a = beam_search(graph, options, sink_a);
+
+    beam_search_options one_thread = options;
+    one_thread.n_threads = 1;
+    candidate_sink sink_b{graph, outfile};
+    const auto b = beam_search(graph, one_thread, sink_b);
+
+    CHECK(std::is_eq(a <=> b));
+
+    std::filesystem::remove(outfile);
+    std::filesystem::remove(outfile + "_enclosed");
+  }
+
+  SECTION("Same result on an implicit graph") {
+    const std::vector<std::size_t> dims{3, 3, 4};
+    const graph_type graph{dims};
+    const implicit_hrp_graph implicit{dims};
+    const auto outfile =
+        (std::filesystem::temp_directory_path() / "hrp_beam_search_test")
+            .string();
+
+    const beam_search_options options{
+        .width = 8, .n_playouts = 2, .seed = 3, .n_threads = 4};
+
+    candidate_sink sink{graph, outfile};
+    const auto best = beam_search(graph, options, sink);
+
+    basic_candidate_sink<implicit_hrp_graph> implicit_sink{implicit, outfile};
+    const auto implicit_best = beam_search(implicit, options, implicit_sink);
+
+    REQUIRE(implicit_best.n_induced() == best.n_induced());
+    for (vertex_id i = 0; i < graph.vertices.size(); ++i) {
+      CHECK(implicit_best.has(i) == best.has(i));
+    }
+    CHECK(implicit_sink.largest() == sink.largest());
+
+    std::filesystem::remove(outfile);
+    std::filesystem::remove(outfile + "_enclosed");
+  }
+}
+
+TEST_CASE("Subtree hash") {
+  const std::vector<std::size_t> dims{3, 3};
+  const graph_type graph{dims};
+
+  SECTION("Hash does not depend on insertion order") {
+    subtree_type a{graph, 4};
+    a.add(1);
+    a.add(7);
+
+    subtree_type b{graph, 7};
+    b.add(4);
+    b.add(1);
+
+    CHECK(a.hash() == b.hash());
+  }
+
+  SECTION("Removing a vertex restores the hash") {
+    subtree_type sub{graph, 4};
+    const auto before = sub.hash();
+    sub.add(3);
+    CHECK(sub.hash() != before);
+    sub.rem(3);
+    CHECK(sub.hash() == before);
+  }
+}
@@ -0,0 +1,29 @@
+#include "big_uint.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("Big uint") {
+  SECTION("Zero") {
+    CHECK(big_uint{}.to_string() == "0");
+    CHECK(big_uint{0} == big_uint{});
+    CHECK(big_uint{std::vector<std::uint32_t>{0, 0}} == big_uint{});
+  }
+
+  SECTION("Counts past 64 bits") {
+    // 2^64 is 18446744073709551616.
+    big_uint count{~std::uint64_t{0}};
+    count += big_uint{1};
+    CHECK(count.to_string() == "18446744073709551616");
+    CHECK(count == big_uint{std::vector<std::uint32_t>{0, 0, 1}});
+  }
+
+  SECTION("Zeros within the digits") {
+    // 10^18 + 7, whose middle chunk of 9 digits is all zeros.
+    big_uint value{1'000'000'000'000'000'000};
+    value += big_uint{7};
+    CHECK(value.to_string() == "1000000000000000007");
+  }
+}
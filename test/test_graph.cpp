@@ -1,4 +1,5 @@
 #include "graph.hpp"
+#include "implicit_graph.hpp"
 #include "static_graph.hpp"
 #include <algorithm>
 #include <array>
@@ -50,43 +51,51 @@ void compare_directions(const container_t &directions, const graph_t &graph) {
 TEST_CASE("dimensions: {1}") {
   static_hrp_graph<1> s_graph;
   hrp_graph r_graph{1};
+  implicit_hrp_graph i_graph{1};
 
   std::vector<std::vector<std::size_t>> neighbors{{}};
 
   compare_neighbors(neighbors, s_graph);
   compare_neighbors(neighbors, r_graph);
+  compare_neighbors(neighbors, i_graph);
 
   std::vector<std::vector<std::size_t>> directions{
       {global_no_vertex, global_no_vertex}};
 
   compare_directions(directions, s_graph);
   compare_directions(directions, r_graph);
+  compare_directions(directions, i_graph);
 }
 
 TEST_CASE("dimensions: {1,1}") {
   static_hrp_graph<1, 1> s_graph;
   hrp_graph r_graph{1, 1};
+  implicit_hrp_graph i_graph{1, 1};
 
   std::vector<std::vector<std::size_t>> neighbors{{}};
 
   compare_neighbors(neighbors, s_graph);
   compare_neighbors(neighbors, r_graph);
+  compare_neighbors(neighbors, i_graph);
 
   std::vector<std::vector<std::size_t>> directions{
       {global_no_vertex, global_no_vertex, global_no_vertex, global_no_vertex}};
 
   compare_directions(directions, s_graph);
   compare_directions(directions, r_graph);
+  compare_directions(directions, i_graph);
 }
 
 TEST_CASE("dimensions: {1,1,1}") {
   static_hrp_graph<1, 1, 1> s_graph;
   hrp_graph r_graph{1, 1, 1};
+  implicit_hrp_graph i_graph{1, 1, 1};
 
   std::vector<std::vector<std::size_t>> neighbors{{}};
 
   compare_neighbors(neighbors, s_graph);
   compare_neighbors(neighbors, r_graph);
+  compare_neighbors(neighbors, i_graph);
 
   std::vector<std::vector<std::size_t>> directions{
       {global_no_vertex, global_no_vertex, global_no_vertex, global_no_vertex,
@@ -94,33 +103,39 @@ TEST_CASE("dimensions: {1,1,1}") {
 
   compare_directions(directions, s_graph);
   compare_directions(directions, r_graph);
+  compare_directions(directions, i_graph);
 }
 
 TEST_CASE("dimensions: {2}") {
   static_hrp_graph<2> s_graph;
   hrp_graph r_graph{2};
+  implicit_hrp_graph i_graph{2};
 
   std::vector<std::vector<std::size_t>> neighbors{{1}, {0}};
 
   compare_neighbors(neighbors, s_graph);
   compare_neighbors(neighbors, r_graph);
+  compare_neighbors(neighbors, i_graph);
 
   std::vector<std::vector<std::size_t>> directions{{global_no_vertex, 1},
                                                    {0, global_no_vertex}};
 
   compare_directions(directions, s_graph);
   compare_directions(directions, r_graph);
+  compare_directions(directions, i_graph);
 }
 
 TEST_CASE("dimensions: {2,2}") {
   static_hrp_graph<2, 2> s_graph;
   hrp_graph r_graph{2, 2};
+  implicit_hrp_graph i_graph{2, 2};
 
   std::vector<std::vector<std::size_t>> neighbors{
       {1, 2}, {0, 3}, {0, 3}, {1, 2}};
 
   compare_neighbors(neighbors, s_graph);
   compare_neighbors(neighbors, r_graph);
+  compare_neighbors(neighbors, i_graph);
 
   std::vector<std::vector<std::size_t>> directions{
       {global_no_vertex, global_no_vertex, 1, 2},
@@ -130,17 +145,20 @@ TEST_CASE("dimensions: {2,2}") {
 
   compare_directions(directions, s_graph);
   compare_directions(directions, r_graph);
+  compare_directions(directions, i_graph);
 }
 
 TEST_CASE("dimensions: {3,2}") {
   static_hrp_graph<3, 2> s_graph;
   hrp_graph r_graph{3, 2};
+  implicit_hrp_graph i_graph{3, 2};
 
   std::vector<std::vector<std::size_t>> neighbors{{1, 3}, {0, 2, 4}, {1, 5},
                                                   {0, 4}, {1, 3, 5}, {2, 4}};
 
   compare_neighbors(neighbors, s_graph);
   compare_neighbors(neighbors, r_graph);
+  compare_neighbors(neighbors, i_graph);
 
   std::vector<std::vector<std::size_t>> directions{
       {global_no_vertex, global_no_vertex, 1, 3},
@@ -152,17 +170,20 @@ TEST_CASE("dimensions: {3,2}") {
 
   compare_directions(directions, s_graph);
   compare_directions(directions, r_graph);
+  compare_directions(directions, i_graph);
 }
 
 TEST_CASE("dimensions: {3,2,1}") {
   static_hrp_graph<3, 2, 1> s_graph;
   hrp_graph r_graph{3, 2, 1};
+  implicit_hrp_graph i_graph{3, 2, 1};
 
   std::vector<std::vector<std::size_t>> neighbors{{1, 3}, {0, 2, 4}, {1, 5},
                                                   {0, 4}, {1, 3, 5}, {2, 4}};
 
   compare_neighbors(neighbors, s_graph);
   compare_neighbors(neighbors, r_graph);
+  compare_neighbors(neighbors, i_graph);
 
   std::vector<std::vector<std::size_t>> directions{
       {global_no_vertex, global_no_vertex, global_no_vertex, 1, 3,
@@ -178,4 +199,25 @@ TEST_CASE("dimensions: {3,2,1}") {
 
   compare_directions(directions, s_graph);
   compare_directions(directions, r_graph);
+  compare_directions(directions, i_graph);
+}
+
+TEST_CASE("implicit graph matches hrp_graph") {
+  const std::vector<std::vector<hrp_graph::vertex_id>> all_dims{
+      {}, {5}, {4, 1, 3}, {2, 3, 4}, {3, 3, 3}, {2, 2, 2, 2}};
+
+  for (const auto &dims : all_dims) {
+    const hrp_graph r_graph{dims};
+    const implicit_hrp_graph i_graph{dims};
+    REQUIRE(i_graph.vertices.size() == r_graph.vertices.size());
+
+    for (hrp_graph::vertex_id i = 0; i < r_graph.vertices.size(); ++i) {
+      const auto vertex = i_graph.vertices[i];
+      CHECK(std::ranges::equal(vertex.neighbors,
+                               r_graph.vertices[i].neighbors));
+      CHECK(std::ranges::equal(vertex.directions,
+                               r_graph.vertices[i].directions));
+      CHECK(i_graph.is_on_outer_shell(i) == r_graph.is_on_outer_shell(i));
+    }
+  }
 }
@@ -0,0 +1,47 @@
+#include "slice_graph.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+TEST_CASE("Slice graph") {
+  SECTION("Dims = {}") {
+    const auto &graph = slice_graph::get(std::vector<std::size_t>{}, false);
+    REQUIRE(graph.slices().size() == 2);
+    CHECK(graph.slices()[0].n_induced == 0);
+    CHECK(graph.slices()[1].n_induced == 1);
+
+    // Either cell can follow either, as there is nothing to form a cycle.
+    REQUIRE(graph.vertices().size() == 2);
+    CHECK(graph.n_edges() == 4);
+  }
+
+  SECTION("Dims = {3}, unpruned") {
+    const auto &graph = slice_graph::get(std::vector<std::size_t>{3}, false);
+
+    // Every subset of a path is acyclic.
+    CHECK(graph.slices().size() == 8);
+    CHECK(&graph == &slice_graph::get(std::vector<std::size_t>{3}, false));
+  }
+
+  SECTION("Dims = {3, 4}, pruned") {
+    // The same as the compile-time slice graph this replaced.
+    const auto &graph = slice_graph::get(std::vector<std::size_t>{3, 4}, true);
+    CHECK(graph.slices().size() == 369);
+    CHECK(graph.vertices().size() == 2006);
+    CHECK(graph.n_edges() == 516803);
+  }
+
+  SECTION("Maximum induced forests") {
+    const auto max_forest = [](std::vector<std::size_t> dims) {
+      const auto length = dims.back();
+      dims.pop_back();
+      return max_prism_forest(slice_graph::get(dims, true), length);
+    };
+
+    CHECK(max_forest({2, 5}) == 8);
+    CHECK(max_forest({3, 3}) == 7);
+    CHECK(max_forest({4, 3}) == 9);
+    CHECK(max_forest({3, 4, 5}) == 39);
+  }
+}
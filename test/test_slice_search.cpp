@@ -0,0 +1,86 @@
+#include "max_plus.hpp"
+#include "slice_search.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+const slice_graph &pruned(std::vector<std::size_t> dims) {
+  return slice_graph::get(dims, true);
+}
+
+} // namespace
+
+TEST_CASE("Densest tiles") {
+  SECTION("By cycle ratio") {
+    const auto tile = max_density_tile(pruned({3, 3}));
+    REQUIRE(tile);
+    CHECK(tile->density == fraction{58, 90});
+
+    // The cycle has 10 slices, which repeat until they fit end to end.
+    CHECK(tile->path.vertices().size() % 10 == 0);
+  }
+
+  SECTION("By paths, bounded or not") {
+    for (const auto &dims : {std::vector<std::size_t>{3}, {2, 2}, {2, 5},
+                            {2, 2, 3}}) {
+      const auto &graph = pruned(dims);
+      const auto best = max_density_tile(graph);
+      REQUIRE(best);
+
+      for (const auto bounded : {false, true}) {
+        const auto tile = max_density_tile_by_paths(graph, bounded);
+        REQUIRE(tile);
+        CHECK(tile->density == best->density);
+      }
+    }
+  }
+}
+
+TEST_CASE("Largest prisms") {
+  SECTION("Same as the forest walk") {
+    const auto &graph = pruned({3, 3});
+    for (std::size_t length = 0; length <= 8; ++length) {
+      const auto prism = max_prism(graph, length);
+      CHECK(prism.n_induced == max_prism_forest(graph, length));
+      CHECK(prism.path.vertices().size() == length);
+      CHECK(max_prism_by_power(graph, length) == prism.n_induced);
+    }
+  }
+
+  SECTION("Longer by power") {
+    CHECK(max_prism_by_power(pruned({2, 2}), 40) == 100);
+    CHECK(max_prism_by_power(pruned({3, 3}), 40) == 233);
+    CHECK(!max_prism_by_power(pruned({3, 3}), max_plus_matrix::max));
+  }
+
+  SECTION("Periods") {
+    // The layers only repeat from length 4, but the maximum is periodic from
+    // the start.
+    const auto period = find_prism_period(pruned({3, 3}), 100);
+    REQUIRE(period);
+    CHECK(period->start == 1);
+    CHECK(period->period == 10);
+    CHECK(period->gain == 58);
+
+    const auto later = find_prism_period(pruned({2, 5}), 100);
+    REQUIRE(later);
+    CHECK(later->start == 2);
+    CHECK(later->period == 2);
+    CHECK(later->gain == 13);
+
+    CHECK(!find_prism_period(pruned({3, 3}), 5));
+  }
+}
+
+TEST_CASE("Largest trees") {
+  const auto &graph = slice_graph::get(std::vector<std::size_t>{2, 2}, false);
+  CHECK(max_prism_trees(graph, 6) ==
+        std::vector<std::size_t>{0, 3, 5, 8, 10, 13, 15});
+
+  const auto &larger = slice_graph::get(std::vector<std::size_t>{3, 3}, false);
+  CHECK(max_prism_trees(larger, 12).back() == 70);
+}
@@ -0,0 +1,86 @@
+#include "enumerate_subtrees.hpp"
+#include "subtree_sampler.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <map>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief Draws many subtrees of a graph, and checks they are all subtrees
+ * that enumeration finds, each drawn about equally often.
+ * @param dims The dimensions of the graph
+ * @param size The size to draw, or none to draw any
+ */
+void check_uniform(const std::vector<std::size_t> &dims,
+                   std::optional<vertex_id> size) {
+  const graph_type graph{dims};
+
+  std::map<subtree_type, std::size_t> counts;
+  for (const auto &sub : enumerate(graph)) {
+    if (!size || sub.n_induced() == *size) {
+      counts.emplace(sub, 0);
+    }
+  }
+
+  const subtree_zdd zdd{graph};
+  const auto sampler = size ? subtree_sampler{zdd, *size} : subtree_sampler{zdd};
+
+  const std::size_t expected = 400;
+  const auto n = expected * counts.size();
+  std::vector<std::vector<vertex_id>> samples(n);
+  sampler.sample(n, 7, [&](std::size_t i, std::span<const vertex_id> induced) {
+    samples[i].assign(induced.begin(), induced.end());
+  });
+
+  for (const auto &induced : samples) {
+    const auto sub = induced.empty() ? subtree_type{graph}
+                                     : subtree_type{graph, induced};
+    const auto it = counts.find(sub);
+    REQUIRE(it != counts.end());
+    ++it->second;
+  }
+
+  // Each count is binomial, with a standard deviation just under 20, so none
+  // should be more than 5 of them from what is expected.
+  const auto tolerance =
+      static_cast<std::size_t>(5 * std::sqrt(static_cast<double>(expected)));
+  for (const auto &[sub, count] : counts) {
+    CHECK(count + tolerance >= expected);
+    CHECK(count <= expected + tolerance);
+  }
+}
+
+TEST_CASE("Subtree sampler") {
+  SECTION("Any size, Dims = {5}") { check_uniform({5}, std::nullopt); }
+  SECTION("Any size, Dims = {3, 3}") { check_uniform({3, 3}, std::nullopt); }
+  SECTION("Size 0, Dims = {3, 3}") { check_uniform({3, 3}, 0); }
+  SECTION("Size 5, Dims = {3, 3}") { check_uniform({3, 3}, 5); }
+  SECTION("Size 7, Dims = {2, 2, 3}") { check_uniform({2, 2, 3}, 7); }
+
+  SECTION("Same samples with any number of threads") {
+    const std::vector<std::size_t> dims{3, 3, 3};
+    const graph_type graph{dims};
+    const subtree_zdd zdd{graph};
+    const subtree_sampler sampler{zdd, 10};
+
+    const std::size_t n = 10000;
+    std::vector<std::vector<vertex_id>> one(n), many(n);
+    sampler.sample(
+        n, 42,
+        [&](std::size_t i, std::span<const vertex_id> induced) {
+          one[i].assign(induced.begin(), induced.end());
+        },
+        1);
+    sampler.sample(
+        n, 42,
+        [&](std::size_t i, std::span<const vertex_id> induced) {
+          many[i].assign(induced.begin(), induced.end());
+        },
+        4);
+    CHECK(one == many);
+    CHECK(one.front().size() == 10);
+  }
+}
@@ -0,0 +1,53 @@
+#include "enumerate_subtrees.hpp"
+#include "subtree_zdd.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <set>
+#include <vector>
+
+/**
+ * @brief Builds the diagram of a graph, and checks it has the same number of
+ * subtrees of each size as enumeration finds, and a largest subtree that
+ * enumeration finds too.
+ * @param dims The dimensions of the graph
+ */
+void check_against_enumeration(const std::vector<std::size_t> &dims) {
+  const graph_type graph{dims};
+
+  std::vector<big_uint> by_size;
+  std::set<subtree_type> subtrees;
+  for (const auto &sub : enumerate(graph)) {
+    if (by_size.size() <= sub.n_induced()) {
+      by_size.resize(sub.n_induced() + 1);
+    }
+    by_size[sub.n_induced()] += big_uint{1};
+    subtrees.emplace(sub);
+  }
+
+  const subtree_zdd zdd{graph};
+  CHECK(zdd.count_by_size() == by_size);
+  CHECK(zdd.max_size() + 1 == by_size.size());
+
+  const auto largest = zdd.max_subtree();
+  CHECK(largest.n_induced() == zdd.max_size());
+  CHECK(subtrees.contains(largest));
+}
+
+TEST_CASE("Subtree ZDD") {
+  SECTION("Dims = {}") { check_against_enumeration({}); }
+  SECTION("Dims = {1}") { check_against_enumeration({1}); }
+  SECTION("Dims = {5}") { check_against_enumeration({5}); }
+  SECTION("Dims = {3, 3}") { check_against_enumeration({3, 3}); }
+  SECTION("Dims = {4, 3}") { check_against_enumeration({4, 3}); }
+  SECTION("Dims = {2, 2, 3}") { check_against_enumeration({2, 2, 3}); }
+  SECTION("Dims = {2, 3, 3}") { check_against_enumeration({2, 3, 3}); }
+
+  SECTION("Same diagram with any number of threads") {
+    const std::vector<std::size_t> dims{3, 3, 3};
+    const graph_type graph{dims};
+    const subtree_zdd one{graph, 1}, many{graph, 4};
+    CHECK(one.nodes().size() == many.nodes().size());
+    CHECK(one.count_by_size() == many.count_by_size());
+  }
+}
@@ -0,0 +1,52 @@
+#include "reference_enumerator.hpp"
+#include "slice_graph.hpp"
+#include "upper_bound.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <vector>
+
+TEST_CASE("Upper bound") {
+  SECTION("Exact where the cross-section is small enough") {
+    const std::vector<std::size_t> dims{3, 4, 5};
+    const upper_bound_table bounds{dims, 12};
+    CHECK(bounds(dims) == 39);
+    CHECK(bounds(std::vector<std::size_t>{3, 3, 1}) == 7);
+    CHECK(bounds(std::vector<std::size_t>{3, 0, 5}) == 0);
+  }
+
+  SECTION("Bounds the largest subtree") {
+    for (const std::vector<std::size_t> &dims :
+         {std::vector<std::size_t>{3, 3}, {2, 2, 3}, {2, 3, 3}}) {
+      const graph_type graph{dims};
+      vertex_id largest = 0;
+      for (const auto &sub : testing::brute_force_enumerate(graph)) {
+        largest = std::max(largest, sub.n_induced());
+      }
+
+      // Only cross-sections of up to 2 cells are solved, so most boxes are cut.
+      const upper_bound_table bounds{dims, 2};
+      CHECK(bounds(dims) >= largest);
+    }
+  }
+
+  SECTION("Lines are solved even with no cells allowed") {
+    const std::vector<std::size_t> dims{3, 3};
+    const upper_bound_table bounds{dims, 0};
+    CHECK(bounds(dims) == 9);
+    CHECK(bounds(std::vector<std::size_t>{1, 3}) == 3);
+  }
+
+  SECTION("Slabs add up to the bound") {
+    const std::vector<std::size_t> dims{6, 5, 4};
+    const upper_bound_table bounds{dims, 6};
+
+    std::size_t total = 0;
+    for (const auto &slab : bounds.slabs(dims)) {
+      total += bounds(slab);
+    }
+    CHECK(total == bounds(dims));
+    CHECK(bounds(dims) <= bounds(std::vector<std::size_t>{6, 5, 2}) * 2);
+  }
+}